@@ -0,0 +1,12 @@
+# -------------------------------------------------------------------
+# Project file for the action log converter
+#
+# See 'Tools/qmake/README' for an overview of the build system
+# -------------------------------------------------------------------
+
+include(../BaseClient/baseservice.pri)
+
+TARGET = actionlog-convert
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,177 @@
+/*
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE COMPUTER, INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE COMPUTER, INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QStringList>
+#include <QTemporaryFile>
+
+#include "wtf/ActionLogReport.h"
+
+/**
+ * Action log converter
+ *
+ * Converts ER_actionlog files between the raw format (read by the race detector) and the compact encoded
+ * format (see wtf/ActionLogEncoding.h). Range commands (see -range-actionlog of the record and replay clients)
+ * are expanded to one command per location in the raw format.
+ *
+ * With -benchmark the file is written in both formats, and the size and decode speed of each are reported.
+ * With -summary a summary of the memory accesses is written instead (see wtf/ActionLogSummary.h).
+ * With -arcs the happens-before arcs are printed in the format of the arcs.log written by the replay client.
+ */
+
+namespace {
+
+QString temporaryPath(const QString& name)
+{
+    QTemporaryFile file(QDir::tempPath() + "/" + name + ".XXXXXX");
+    file.setAutoRemove(false);
+    file.open();
+    return file.fileName();
+}
+
+bool benchmarkDecode(const char* name, const QString& path, int iterations)
+{
+    size_t numCommands = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < iterations; ++i) {
+        if (!ActionLogDecode(path.toStdString(), &numCommands)) {
+            std::cerr << "Could not decode " << path.toStdString() << std::endl;
+            return false;
+        }
+    }
+
+    double seconds = timer.elapsed() / 1000.0 / iterations;
+    qint64 size = QFileInfo(path).size();
+
+    std::cout << name << ": " << size << " bytes, " << numCommands << " commands, "
+              << seconds * 1000 << " ms per decode";
+    if (seconds > 0) {
+        std::cout << " (" << size / seconds / (1024 * 1024) << " MB/s, " << numCommands / seconds << " commands/s)";
+    }
+    std::cout << std::endl;
+
+    return true;
+}
+
+int benchmark(const QString& inPath, int iterations)
+{
+    QString rawPath = temporaryPath("ER_actionlog.raw");
+    QString encodedPath = temporaryPath("ER_actionlog.encoded");
+
+    bool ok = ActionLogConvert(inPath.toStdString(), rawPath.toStdString(), ActionLogRaw) &&
+              ActionLogConvert(inPath.toStdString(), encodedPath.toStdString(), ActionLogEncoded);
+
+    if (ok) {
+        ok = benchmarkDecode("raw", rawPath, iterations) && benchmarkDecode("encoded", encodedPath, iterations);
+    } else {
+        std::cerr << "Could not read " << inPath.toStdString() << std::endl;
+    }
+
+    if (ok) {
+        std::cout << "compression ratio: " << (double) QFileInfo(rawPath).size() / QFileInfo(encodedPath).size() << std::endl;
+    }
+
+    QFile::remove(rawPath);
+    QFile::remove(encodedPath);
+
+    return ok ? 0 : 1;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments();
+
+    if (args.contains("-help") || args.size() < 3) {
+        std::cerr << "Usage: " << args.at(0).toStdString() << " [-raw|-encoded] <in ER_actionlog> <out ER_actionlog>" << std::endl;
+        std::cerr << "       " << args.at(0).toStdString() << " -benchmark [-iterations N] <ER_actionlog>" << std::endl;
+        std::cerr << "       " << args.at(0).toStdString() << " -summary <ER_actionlog> <out ER_summary>" << std::endl;
+        std::cerr << "       " << args.at(0).toStdString() << " -arcs <ER_actionlog>" << std::endl;
+        return 1;
+    }
+
+    int iterations = 5;
+    int iterationsIndex = args.indexOf("-iterations");
+    if (iterationsIndex != -1 && iterationsIndex + 1 < args.size()) {
+        iterations = qMax(1, args.at(iterationsIndex + 1).toInt());
+        args.removeAt(iterationsIndex + 1);
+        args.removeAt(iterationsIndex);
+    }
+
+    if (args.at(1) == "-benchmark") {
+        return benchmark(args.at(2), iterations);
+    }
+
+    if (args.at(1) == "-summary") {
+        if (args.size() != 4 || !ActionLogSummarize(args.at(2).toStdString(), args.at(3).toStdString())) {
+            std::cerr << "Could not summarize " << args.value(2).toStdString() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (args.at(1) == "-arcs") {
+        std::vector<ActionLog::Arc> arcs;
+        if (args.size() != 3 || !ActionLogReadArcs(args.at(2).toStdString(), &arcs)) {
+            std::cerr << "Could not read " << args.value(2).toStdString() << std::endl;
+            return 1;
+        }
+        for (std::vector<ActionLog::Arc>::const_iterator it = arcs.begin(); it != arcs.end(); ++it) {
+            std::cout << it->m_tail << " -> " << it->m_head << std::endl;
+        }
+        return 0;
+    }
+
+    ActionLogFileFormat format = ActionLogEncoded;
+    if (args.at(1) == "-raw" || args.at(1) == "-encoded") {
+        format = args.at(1) == "-raw" ? ActionLogRaw : ActionLogEncoded;
+        args.removeAt(1);
+    }
+
+    if (args.size() != 3) {
+        std::cerr << "Expected an input and an output file" << std::endl;
+        return 1;
+    }
+
+    if (!ActionLogConvert(args.at(1).toStdString(), args.at(2).toStdString(), format)) {
+        std::cerr << "Could not convert " << args.at(1).toStdString() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -37,11 +37,7 @@
 #include "locationedit.h"
 
 #include <QAction>
-#include <QFileInfo>
 #include <QDebug>
-#include <QImage>
-#include <QSize>
-#include <QPainter>
 
 BaseWindow::BaseWindow()
     : m_page(new QWebPage(this))
@@ -115,17 +111,7 @@ void BaseWindow::setAddressUrl(const QString& url)
 
 void BaseWindow::load(const QString& url)
 {
-    QString input(url);
-
-    QFileInfo fi(input);
-    if (fi.exists() && fi.isRelative())
-        input = fi.absoluteFilePath();
-
-    QUrl qurl = QUrl::fromUserInput(input);
-
-    if (qurl.scheme().isEmpty())
-        qurl = QUrl("http://" + url + "/");
-    load(qurl);
+    load(urlFromUserInput(url));
 }
 
 void BaseWindow::load(const QUrl& url)
@@ -172,32 +158,3 @@ void BaseWindow::closeEvent(QCloseEvent *event)
     emit sigOnCloseEvent();
     QMainWindow::closeEvent(event);
 }
-
-void BaseWindow::takeScreenshot(const QString &destinationFile)
-{
-    page()->mainFrame()->setScrollBarPolicy(Qt::Vertical, Qt::ScrollBarAlwaysOff);
-    page()->mainFrame()->setScrollBarPolicy(Qt::Horizontal, Qt::ScrollBarAlwaysOff);
-    page()->setViewportSize(page()->mainFrame()->contentsSize());
-
-    QSize size = page()->mainFrame()->contentsSize();
-
-    if (size.width() == 0) {
-        size.setWidth(1024);
-    }
-
-    if (size.height() == 0) {
-        size.setHeight(1024);
-    }
-
-    QImage image(size, QImage::Format_ARGB32_Premultiplied);
-    image.fill(Qt::transparent);
-
-    QPainter p(&image);
-    p.setRenderHint(QPainter::Antialiasing, true);
-    p.setRenderHint(QPainter::TextAntialiasing, true);
-    p.setRenderHint(QPainter::SmoothPixmapTransform, true);
-    page()->mainFrame()->render(&p);
-    p.end();
-
-    image.save(destinationFile);
-}
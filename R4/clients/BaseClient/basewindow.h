@@ -39,23 +39,28 @@
 #include <QWebFrame>
 #include <QWebPage>
 
+#include "clientwindow.h"
+
 class LocationEdit;
 
-class BaseWindow : public QMainWindow {
+class BaseWindow : public QMainWindow, public ClientWindow {
     Q_OBJECT
 
 public:
     BaseWindow();
 
+    QObject* object() { return this; }
+
     void load(const QString& url);
     void load(const QUrl& url);
 
     QWebPage* page() const;
     void setPage(QWebPage*);
 
-    void closeEvent(QCloseEvent *event);
+    void show() { QMainWindow::show(); }
+    bool close() { return QMainWindow::close(); }
 
-    void takeScreenshot(const QString& destinationFile);
+    void closeEvent(QCloseEvent *event);
 
 signals:
     void sigOnCloseEvent();
@@ -1,9 +1,46 @@
 
+#include <fstream>
+#include <string.h>
+
+#include <QRegExp>
+#include <QSize>
+
+#include <WebCore/platform/ThreadTimers.h>
+#include <WebCore/platform/ThreadGlobalData.h>
+#include <DumpRenderTreeSupportQt.h>
+
 #include "clientapplication.h"
+#include "headlesswindow.h"
+
+static bool hasHeadlessOption(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-headless") == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Headless clients run on an offscreen Qt platform, such that no display server is needed. This must be
+// decided before QApplication connects to the window system. It takes effect with Qt builds using the
+// platform abstraction (QPA), X11 builds of Qt still need a display (but no widgets are created).
+static int& prepareHeadless(int& argc, char** argv)
+{
+    if (hasHeadlessOption(argc, argv) && qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "minimal");
+    }
+
+    return argc;
+}
 
 ClientApplication::ClientApplication(int& argc, char** argv)
-    : QApplication(argc, argv, QApplication::GuiServer)
+    : QApplication(prepareHeadless(argc, argv), argv, QApplication::GuiServer)
     , m_programName("record")
+    , m_headless(hasHeadlessOption(argc, argv))
+    , m_contentHashLogEnabled(false)
+    , m_windowClosed(false)
 {
     applyDefaultSettings();
 
@@ -16,7 +53,23 @@ ClientApplication::ClientApplication(int& argc, char** argv)
     // Important, accessible from the JS environment
     this->setApplicationName("R4");
 
-    m_window = new ToolWindow();
+    if (m_headless) {
+        m_window = new HeadlessWindow();
+    } else {
+        m_window = new ToolWindow();
+    }
+
+    QObject::connect(m_window->object(), SIGNAL(sigOnCloseEvent()), this, SLOT(slWindowClosed()));
+
+    WebCore::threadGlobalData().threadTimers().eventActionRegister()->registerEventActionObserver(
+                &ClientApplication::eventActionObserver,
+                this);
+}
+
+ClientApplication::~ClientApplication()
+{
+    // Deferred screenshots are encoded in the background, finish them before exiting
+    ClientWindow::waitForScreenshots();
 }
 
 void ClientApplication::loadWebsite(QString url)
@@ -30,4 +83,90 @@ void ClientApplication::applyDefaultSettings()
     QWebSettings::setObjectCacheCapacities((16*1024*1024) / 8, (16*1024*1024) / 8, 16*1024*1024);
     QWebSettings::globalSettings()->setAttribute(QWebSettings::PluginsEnabled, true);
     QWebSettings::globalSettings()->setAttribute(QWebSettings::DeveloperExtrasEnabled, true);
+
+    // The HTML-hash of the status file and the domhash log are read from the DOM content hash
+    DumpRenderTreeSupportQt::setContentHashEnabled(true);
+}
+
+quint64 ClientApplication::pageContentHash() const
+{
+    quint64 contentHash = 0; // this will overflow as we are using it, but that is as exptected
+
+    QList<QWebFrame*> queue;
+    queue.append(m_window->page()->mainFrame());
+
+    while (!queue.empty()) {
+        QWebFrame* current = queue.takeFirst();
+        contentHash += current->contentHash();
+        queue.append(current->childFrames());
+    }
+
+    return contentHash;
+}
+
+void ClientApplication::eventActionObserver(void* object, WTF::EventActionId id, const WTF::EventActionDescriptor&)
+{
+    ClientApplication* ths = (ClientApplication*)object;
+
+    if (!ths->m_contentHashLogEnabled || ths->m_windowClosed) {
+        return; // the window (and page) is deleted on close
+    }
+
+    ths->m_contentHashLog.append(qMakePair(id, ths->pageContentHash()));
+}
+
+void ClientApplication::slWindowClosed()
+{
+    m_windowClosed = true;
+}
+
+QString ClientApplication::windowStatus() const
+{
+    QSize viewport = m_window->page()->viewportSize();
+    return QString("Window: %1\nViewport: %2x%3\n").arg(m_headless ? "headless" : "widgets").arg(viewport.width()).arg(viewport.height());
+}
+
+bool ClientApplication::matchRecordedWindow(QString statusPath)
+{
+    QFile fp(statusPath);
+    if (!fp.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return true; // nothing recorded, keep the defaults
+    }
+
+    QRegExp windowPattern("^Window: (\\w+)");
+    QRegExp viewportPattern("^Viewport: ([0-9]+)x([0-9]+)");
+
+    QString window;
+    QSize viewport;
+
+    while (!fp.atEnd()) {
+        QString line = QString::fromAscii(fp.readLine());
+        if (windowPattern.indexIn(line) != -1) {
+            window = windowPattern.cap(1);
+        } else if (viewportPattern.indexIn(line) != -1) {
+            viewport = QSize(viewportPattern.cap(1).toInt(), viewportPattern.cap(2).toInt());
+        }
+    }
+
+    if (window == "headless" && !m_headless) {
+        return false;
+    }
+
+    if (m_headless && !viewport.isEmpty()) {
+        m_window->page()->setViewportSize(viewport);
+    }
+
+    return true;
+}
+
+void ClientApplication::writeContentHashLogFile(QString path)
+{
+    std::ofstream hashfile;
+    hashfile.open(path.toStdString().c_str());
+
+    for (ContentHashLog::const_iterator it = m_contentHashLog.begin(); it != m_contentHashLog.end(); ++it) {
+        hashfile << (*it).first << ";" << (*it).second << std::endl;
+    }
+
+    hashfile.close();
 }
@@ -6,8 +6,13 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QFontDatabase>
+#include <QList>
+#include <QPair>
 #include <QString>
 
+#include <wtf/EventActionDescriptor.h>
+
+#include "clientwindow.h"
 #include "toolwindow.h"
 
 class ClientApplication : public QApplication {
@@ -15,16 +20,50 @@ class ClientApplication : public QApplication {
 
 public:
     ClientApplication(int& argc, char** argv);
+    virtual ~ClientApplication();
 
 protected:
     void loadWebsite(QString url);
 
+    // Hash of the DOM content of all frames, replaces hashing QWebFrame::toHtml()
+    quint64 pageContentHash() const;
+
+    // Collect the page content hash after each event action (domhash.data), disabled by default
+    void setContentHashLogEnabled(bool enabled) { m_contentHashLogEnabled = enabled; }
+    bool contentHashLogEnabled() const { return m_contentHashLogEnabled; }
+
+    // Writes the page content hash observed after each event action
+    void writeContentHashLogFile(QString path);
+
+    // Window mode and viewport size of this run, as status.data lines
+    QString windowStatus() const;
+
+    // Makes the window match the one of a recording, given its status.data. A headless window takes the
+    // recorded viewport size. Returns false if a headless recording is replayed in a window, whose viewport
+    // size depends on the widgets around the view.
+    bool matchRecordedWindow(QString statusPath);
+
 private:
     void applyDefaultSettings();
 
+    static void eventActionObserver(void* object, WTF::EventActionId id, const WTF::EventActionDescriptor& descriptor);
+
+private slots:
+    void slWindowClosed();
+
 protected:
-    ToolWindow* m_window;
+    ClientWindow* m_window;
     QString m_programName;
+
+    // Running without widgets (-headless), see HeadlessWindow
+    bool m_headless;
+
+private:
+    typedef QList<QPair<WTF::EventActionId, quint64> > ContentHashLog;
+    ContentHashLog m_contentHashLog;
+    bool m_contentHashLogEnabled;
+
+    bool m_windowClosed;
 };
 
 #endif // CLIENTAPPLICATION_H
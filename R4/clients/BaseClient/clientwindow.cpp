@@ -0,0 +1,164 @@
+/*
+ * clientwindow.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "clientwindow.h"
+
+#include <QFileInfo>
+#include <QPainter>
+#include <QSize>
+#include <QUrl>
+#include <QWebFrame>
+#include <QWebSettings>
+#include <QFutureSynchronizer>
+#include <QtConcurrentRun>
+
+static QFutureSynchronizer<bool> deferredScreenshots;
+
+static bool saveScreenshot(QImage image, QString destinationFile)
+{
+    return image.save(destinationFile);
+}
+
+QUrl ClientWindow::urlFromUserInput(const QString& url)
+{
+    QString input(url);
+
+    QFileInfo fi(input);
+    if (fi.exists() && fi.isRelative())
+        input = fi.absoluteFilePath();
+
+    QUrl qurl = QUrl::fromUserInput(input);
+
+    if (qurl.scheme().isEmpty())
+        qurl = QUrl("http://" + url + "/");
+
+    return qurl;
+}
+
+quint64 ClientWindow::takeScreenshot(const QString& destinationFile, ScreenshotMode mode, quint64 baseHash,
+                                     quint64* perceptualHash)
+{
+    QImage image = renderScreenshot();
+    quint64 hash = pixelHash(image);
+
+    if (perceptualHash) {
+        *perceptualHash = differenceHash(image);
+    }
+
+    switch (mode) {
+    case ScreenshotEncodeIfChanged:
+        if (hash == baseHash) {
+            break; // identical pixels as the base, the report tooling compares hashes
+        }
+        saveScreenshot(image, destinationFile);
+        break;
+
+    case ScreenshotEncodeDeferred:
+        deferredScreenshots.addFuture(QtConcurrent::run(saveScreenshot, image, destinationFile));
+        break;
+
+    case ScreenshotEncodeAlways:
+    default:
+        saveScreenshot(image, destinationFile);
+        break;
+    }
+
+    return hash;
+}
+
+void ClientWindow::waitForScreenshots()
+{
+    deferredScreenshots.waitForFinished();
+}
+
+QImage ClientWindow::renderScreenshot()
+{
+    // Analysis runs suppress painting, the screenshot is the only paint they need.
+    bool paintingSuppressed = page()->settings()->testAttribute(QWebSettings::PaintingSuppressed);
+    page()->settings()->setAttribute(QWebSettings::PaintingSuppressed, false);
+
+    page()->mainFrame()->setScrollBarPolicy(Qt::Vertical, Qt::ScrollBarAlwaysOff);
+    page()->mainFrame()->setScrollBarPolicy(Qt::Horizontal, Qt::ScrollBarAlwaysOff);
+    page()->setViewportSize(page()->mainFrame()->contentsSize());
+
+    QSize size = page()->mainFrame()->contentsSize();
+
+    if (size.width() == 0) {
+        size.setWidth(1024);
+    }
+
+    if (size.height() == 0) {
+        size.setHeight(1024);
+    }
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter p(&image);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setRenderHint(QPainter::TextAntialiasing, true);
+    p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    page()->mainFrame()->render(&p);
+    p.end();
+
+    page()->settings()->setAttribute(QWebSettings::PaintingSuppressed, paintingSuppressed);
+
+    return image;
+}
+
+/**
+ * 64 bit FNV-1a hash of the image size and pixels.
+ *
+ * Used to decide if two renderings are identical.
+ */
+quint64 ClientWindow::pixelHash(const QImage& image)
+{
+    quint64 hash = 14695981039346656037ULL;
+
+    hash = (hash ^ static_cast<quint64>(image.width())) * 1099511628211ULL;
+    hash = (hash ^ static_cast<quint64>(image.height())) * 1099511628211ULL;
+
+    int lineLength = image.width() * 4; // 32 bit formats, skip the scan line padding
+
+    for (int y = 0; y < image.height(); y++) {
+        const uchar* line = image.constScanLine(y);
+
+        for (int x = 0; x < lineLength; x++) {
+            hash = (hash ^ line[x]) * 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * Difference hash (dHash) of the image.
+ *
+ * The image is scaled down to 9x8 gray scale pixels, and each bit of the hash is set if a pixel
+ * is brighter than its right neighbour. Similar renderings result in hashes with a small
+ * hamming distance. Different renderings can have the same hash, use pixelHash to compare them.
+ */
+quint64 ClientWindow::differenceHash(const QImage& image)
+{
+    QImage small = image.scaled(9, 8, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                        .convertToFormat(QImage::Format_ARGB32);
+
+    quint64 hash = 0;
+
+    for (int y = 0; y < 8; y++) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(small.constScanLine(y));
+
+        for (int x = 0; x < 8; x++) {
+            hash <<= 1;
+            if (qGray(line[x]) > qGray(line[x + 1])) {
+                hash |= 1;
+            }
+        }
+    }
+
+    return hash;
+}
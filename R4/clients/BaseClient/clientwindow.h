@@ -0,0 +1,60 @@
+/*
+ * clientwindow.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef clientwindow_h
+#define clientwindow_h
+
+#include <QImage>
+#include <QObject>
+#include <QString>
+#include <QUrl>
+#include <QWebPage>
+
+/**
+ * The browser window driven by the record and replay clients.
+ *
+ * Implemented by BaseWindow (a QMainWindow with a toolbar and a view) and by HeadlessWindow (a QWebPage
+ * without any widgets, rendered only to take screenshots).
+ */
+class ClientWindow {
+
+public:
+    enum ScreenshotMode {
+        ScreenshotEncodeAlways,     // encode the PNG before returning
+        ScreenshotEncodeDeferred,   // encode the PNG in a background thread
+        ScreenshotEncodeIfChanged   // encode the PNG only if the pixel hash differs from the base hash
+    };
+
+    virtual ~ClientWindow() {}
+
+    // The object emitting sigOnCloseEvent() when the window closes
+    virtual QObject* object() = 0;
+
+    virtual QWebPage* page() const = 0;
+    virtual void load(const QString& url) = 0;
+
+    virtual void show() = 0;
+    virtual bool close() = 0;
+
+    // Renders the page and returns an exact hash of the rendered pixels. The perceptual hash (dHash) of
+    // the rendering is stored in perceptualHash if given, it only measures similarity.
+    quint64 takeScreenshot(const QString& destinationFile, ScreenshotMode mode = ScreenshotEncodeAlways, quint64 baseHash = 0,
+                           quint64* perceptualHash = 0);
+
+    // Blocks until all deferred screenshots are written to disk
+    static void waitForScreenshots();
+
+protected:
+    static QUrl urlFromUserInput(const QString& url);
+
+private:
+    QImage renderScreenshot();
+    static quint64 pixelHash(const QImage& image);
+    static quint64 differenceHash(const QImage& image);
+};
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * headlesswindow.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "headlesswindow.h"
+
+#include <QWebFrame>
+#include <QWebSettings>
+
+HeadlessWindow::HeadlessWindow()
+    : m_page(new QWebPage(this))
+    , m_closed(false)
+{
+    // Layout size of headless recordings. The viewport of a ToolWindow is smaller than the 800x600 window
+    // and depends on its widgets, replays take the recorded size instead (see matchRecordedWindow)
+    m_page->setViewportSize(QSize(800, 600));
+
+    // Same preferences as the windowed clients (ToolWindow)
+
+    QWebSettings* settings = m_page->settings();
+    settings->setAttribute(QWebSettings::AcceleratedCompositingEnabled, false);
+    settings->setAttribute(QWebSettings::TiledBackingStoreEnabled, false);
+    settings->setAttribute(QWebSettings::FrameFlatteningEnabled, false);
+    settings->setAttribute(QWebSettings::WebGLEnabled, false);
+
+    connect(m_page, SIGNAL(windowCloseRequested()), this, SLOT(close()));
+}
+
+HeadlessWindow::~HeadlessWindow()
+{
+}
+
+QWebPage* HeadlessWindow::page() const
+{
+    return m_page;
+}
+
+void HeadlessWindow::load(const QString& url)
+{
+    QUrl qurl = urlFromUserInput(url);
+
+    if (!qurl.isValid())
+        return;
+
+    m_page->mainFrame()->load(qurl);
+}
+
+bool HeadlessWindow::close()
+{
+    if (m_closed)
+        return true;
+    m_closed = true;
+
+    // Mirrors BaseWindow (Qt::WA_DeleteOnClose), the page is deleted once control returns to the event loop
+    emit sigOnCloseEvent();
+    deleteLater();
+
+    return true;
+}
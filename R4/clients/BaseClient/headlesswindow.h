@@ -0,0 +1,47 @@
+/*
+ * headlesswindow.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef headlesswindow_h
+#define headlesswindow_h
+
+#include <QObject>
+#include <QWebPage>
+
+#include "clientwindow.h"
+
+/**
+ * Client window without any widgets (-headless).
+ *
+ * The page is not attached to a view, such that updates of the page do not run the widget, style and paint
+ * machinery. The page is only rendered (into an image) to take screenshots.
+ */
+class HeadlessWindow : public QObject, public ClientWindow {
+    Q_OBJECT
+
+public:
+    HeadlessWindow();
+    virtual ~HeadlessWindow();
+
+    QObject* object() { return this; }
+
+    QWebPage* page() const;
+    void load(const QString& url);
+
+    void show() {}
+
+public slots:
+    bool close();
+
+signals:
+    void sigOnCloseEvent();
+
+private:
+    QWebPage* m_page;
+    bool m_closed;
+};
+
+#endif
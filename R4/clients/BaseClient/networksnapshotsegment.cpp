@@ -0,0 +1,203 @@
+/*
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE COMPUTER, INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE COMPUTER, INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <string.h>
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+
+#include "networksnapshotsegment.h"
+
+namespace {
+
+const char segmentMagic[4] = { 'E', 'R', 'N', 'S' };
+const quint32 segmentVersion = 1;
+
+struct SegmentHeader {
+    char magic[4];
+    quint32 version;
+    quint32 numEntries;
+    quint32 urlsOffset;
+    quint64 logOffset;
+    quint64 logSize;
+};
+
+struct SegmentEntry {
+    quint64 offset; // relative to the network log
+    quint64 length;
+    quint32 sameUrlSequenceNumber;
+    quint32 urlOffset; // relative to the URLs
+    quint32 urlLength;
+    quint32 padding;
+};
+
+}
+
+QString NetworkSnapshotSegment::keyForLog(const QString& logNetworkPath)
+{
+    QByteArray path = QFileInfo(logNetworkPath).canonicalFilePath().toUtf8();
+    return QString("webera-network-") + QString(QCryptographicHash::hash(path, QCryptographicHash::Sha1).toHex());
+}
+
+bool NetworkSnapshotSegment::create(QSharedMemory* memory, const QString& logNetworkPath)
+{
+    QFile fp(logNetworkPath);
+    if (!fp.open(QIODevice::ReadOnly)) {
+        std::cerr << "Error: Could not open network log " << logNetworkPath.toStdString() << std::endl;
+        return false;
+    }
+
+    // Index the network log
+
+    QList<SegmentEntry> entries;
+    QByteArray urls;
+
+    while (!fp.atEnd()) {
+        qint64 start = fp.pos();
+        WebCore::QNetworkReplyInitialSnapshot* snapshot = WebCore::QNetworkReplyInitialSnapshot::deserialize(&fp);
+
+        QByteArray url = snapshot->getUrl().toString().toUtf8();
+
+        SegmentEntry entry;
+        entry.offset = start;
+        entry.length = fp.pos() - start;
+        entry.sameUrlSequenceNumber = snapshot->getSameUrlSequenceNumber();
+        entry.urlOffset = urls.size();
+        entry.urlLength = url.size();
+        entry.padding = 0;
+
+        entries.append(entry);
+        urls.append(url);
+
+        delete snapshot;
+    }
+
+    // Copy everything into the segment
+
+    SegmentHeader header;
+    memcpy(header.magic, segmentMagic, sizeof(segmentMagic));
+    header.version = segmentVersion;
+    header.numEntries = entries.size();
+    header.urlsOffset = sizeof(SegmentHeader) + entries.size() * sizeof(SegmentEntry);
+    header.logOffset = header.urlsOffset + urls.size();
+    header.logSize = fp.size();
+
+    if (!memory->create(header.logOffset + header.logSize)) {
+        std::cerr << "Error: Could not create shared memory segment (" << memory->errorString().toStdString() << ")" << std::endl;
+        return false;
+    }
+
+    memory->lock();
+
+    char* data = static_cast<char*>(memory->data());
+
+    memcpy(data, &header, sizeof(SegmentHeader));
+    for (int i = 0; i < entries.size(); ++i) {
+        memcpy(data + sizeof(SegmentHeader) + i * sizeof(SegmentEntry), &entries.at(i), sizeof(SegmentEntry));
+    }
+    memcpy(data + header.urlsOffset, urls.constData(), urls.size());
+
+    fp.seek(0);
+    bool success = fp.read(data + header.logOffset, header.logSize) == (qint64)header.logSize;
+
+    memory->unlock();
+
+    fp.close();
+
+    if (!success) {
+        std::cerr << "Error: Could not read network log " << logNetworkPath.toStdString() << std::endl;
+        memory->detach();
+    }
+
+    return success;
+}
+
+bool NetworkSnapshotSegment::attach(QSharedMemory* memory, const QString& logNetworkPath)
+{
+    memory->setKey(keyForLog(logNetworkPath));
+
+    if (!memory->attach(QSharedMemory::ReadOnly)) {
+        return false;
+    }
+
+    const SegmentHeader* header = static_cast<const SegmentHeader*>(memory->constData());
+
+    if (memory->size() < (int)sizeof(SegmentHeader) ||
+            memcmp(header->magic, segmentMagic, sizeof(segmentMagic)) != 0 ||
+            header->version != segmentVersion) {
+        std::cerr << "Warning: Incompatible network snapshot service segment, ignoring it" << std::endl;
+        memory->detach();
+        return false;
+    }
+
+    return true;
+}
+
+// The segment is never written after it is created, no locking required
+
+static const SegmentEntry* segmentEntry(const char* data, quint32 entry)
+{
+    return reinterpret_cast<const SegmentEntry*>(data + sizeof(SegmentHeader) + entry * sizeof(SegmentEntry));
+}
+
+QList<NetworkSnapshotSegment::IndexEntry> NetworkSnapshotSegment::index(QSharedMemory* memory)
+{
+    QList<IndexEntry> result;
+
+    const char* data = static_cast<const char*>(memory->constData());
+    const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(data);
+
+    for (quint32 i = 0; i < header->numEntries; ++i) {
+        const SegmentEntry* entry = segmentEntry(data, i);
+        result.append(IndexEntry(QString::fromUtf8(data + header->urlsOffset + entry->urlOffset, entry->urlLength), i));
+    }
+
+    return result;
+}
+
+WebCore::QNetworkReplyInitialSnapshot* NetworkSnapshotSegment::snapshot(QSharedMemory* memory, quint32 entryNumber)
+{
+    const char* data = static_cast<const char*>(memory->constData());
+    const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(data);
+    const char* log = data + header->logOffset;
+
+    if (entryNumber >= header->numEntries) {
+        return 0;
+    }
+
+    const SegmentEntry* entry = segmentEntry(data, entryNumber);
+
+    // Deserialize over the shared pages, QByteArray::fromRawData does not copy
+    QByteArray raw = QByteArray::fromRawData(log + entry->offset, entry->length);
+    QBuffer buffer(&raw);
+    buffer.open(QIODevice::ReadOnly);
+
+    return WebCore::QNetworkReplyInitialSnapshot::deserialize(&buffer, log + entry->offset);
+}
@@ -0,0 +1,71 @@
+/*
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE COMPUTER, INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE COMPUTER, INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef NETWORKSNAPSHOTSEGMENT_H
+#define NETWORKSNAPSHOTSEGMENT_H
+
+#include <QList>
+#include <QPair>
+#include <QSharedMemory>
+#include <QString>
+
+#include <JavaScriptCore/runtime/JSExportMacros.h>
+#include <WebCore/platform/network/qt/QNetworkReplyHandler.h>
+
+/**
+ * WebERA:
+ *
+ * A network log (log.network.data) loaded into shared memory by the network snapshot service, such that
+ * concurrent replay workers of the same recording share one copy of every response body.
+ *
+ * Layout: header | index (one entry per initial snapshot) | URLs | the network log as written by the recording
+ *
+ * The index is ordered as the network log, and identifies each snapshot by URL and same URL sequence number.
+ */
+class NetworkSnapshotSegment {
+
+public:
+    // URL and number of each entry in the index, see snapshot()
+    typedef QPair<QString, quint32> IndexEntry;
+
+    // Shared memory key used for a network log
+    static QString keyForLog(const QString& logNetworkPath);
+
+    // Loads the network log into a new segment (used by the service)
+    static bool create(QSharedMemory* memory, const QString& logNetworkPath);
+
+    // Attaches (read-only) to the segment of a network log, returns false if no service is running
+    static bool attach(QSharedMemory* memory, const QString& logNetworkPath);
+
+    // Reads the index of an attached segment, without deserializing any snapshot
+    static QList<IndexEntry> index(QSharedMemory* memory);
+
+    // Deserializes one snapshot of an attached segment, response bodies reference the shared pages directly.
+    // The segment must stay attached for the lifetime of the snapshot.
+    static WebCore::QNetworkReplyInitialSnapshot* snapshot(QSharedMemory* memory, quint32 entry);
+};
+
+#endif // NETWORKSNAPSHOTSEGMENT_H
@@ -0,0 +1,108 @@
+/*
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE COMPUTER, INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE COMPUTER, INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <csignal>
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QSharedMemory>
+#include <QStringList>
+#include <QTimer>
+
+#include "networksnapshotsegment.h"
+
+/**
+ * Network snapshot service
+ *
+ * Loads a network log (log.network.data) into shared memory once, such that concurrent replays of the same
+ * recording (started with -network-service) share the response bodies instead of each reading the log.
+ *
+ * The segment is removed when the service is stopped (SIGINT or SIGTERM) and the last replay has detached.
+ */
+
+namespace {
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void requestStop(int)
+{
+    stopRequested = 1;
+}
+
+}
+
+class NetworkServiceApplication : public QCoreApplication {
+    Q_OBJECT
+
+public:
+    NetworkServiceApplication(int& argc, char** argv)
+        : QCoreApplication(argc, argv)
+    {
+        connect(&m_stopTimer, SIGNAL(timeout()), this, SLOT(slPollStop()));
+        m_stopTimer.start(200);
+    }
+
+public slots:
+    void slPollStop()
+    {
+        if (stopRequested) {
+            quit();
+        }
+    }
+
+private:
+    QTimer m_stopTimer;
+};
+
+int main(int argc, char** argv)
+{
+    NetworkServiceApplication app(argc, argv);
+
+    QStringList args = app.arguments();
+
+    if (args.size() != 2 || args.contains("-help")) {
+        std::cerr << "Usage: " << args.at(0).toStdString() << " <log.network.data>" << std::endl;
+        return 1;
+    }
+
+    QString logNetworkPath = args.at(1);
+
+    QSharedMemory memory(NetworkSnapshotSegment::keyForLog(logNetworkPath));
+
+    if (!NetworkSnapshotSegment::create(&memory, logNetworkPath)) {
+        return 1;
+    }
+
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+
+    // Scripts wait for this line before starting the replays
+    std::cout << "Serving " << logNetworkPath.toStdString() << " (" << memory.size() << " bytes) as " << memory.key().toStdString() << std::endl;
+
+    return app.exec();
+}
+
+#include "main.moc"
@@ -0,0 +1,12 @@
+# -------------------------------------------------------------------
+# Project file for the network snapshot service binary
+#
+# See 'Tools/qmake/README' for an overview of the build system
+# -------------------------------------------------------------------
+
+include(../BaseClient/baseservice.pri)
+
+TARGET = network-service
+
+SOURCES += \
+    main.cpp
@@ -32,12 +32,21 @@
 #include <QDebug>
 #include <QWebPage>
 
-AutoExplorer::AutoExplorer(QMainWindow* window, QWebFrame* frame)
+#include <WebCore/platform/ThreadTimers.h>
+#include <WebCore/platform/ThreadGlobalData.h>
+#include <WebCore/platform/network/qt/QNetworkReplyHandler.h>
+
+AutoExplorer::AutoExplorer(ClientWindow* window, QWebFrame* frame)
     : m_window(window)
     , m_frame(frame)
     , m_numFramesLoading(0)
     , m_numEventActionsExploredLimit(128)
     , m_numFailedExplorationAttempts(0)
+    , m_numNonQuiescentPolls(0)
+    , m_minimumGap(50)
+    , m_batchSize(1)
+    , m_maximumQuiescenceWait(2000)
+    , m_idleTimeout(5000)
 {
 
     // Track the current number of frames being loaded
@@ -79,33 +88,93 @@ void AutoExplorer::explore(const QString& url, unsigned int preExploreTimeout, u
 
     // This timer is used to invoke each auto explored event action
     // The event action is invoked immediately when this timer is fired (it is not deferred to an internal timer)
+    // The timer polls for quiescence, the next event action is fired as soon as the page is idle
 
-    m_explorationKeepAliveTimer.setInterval(500); // 500 ms
+    m_explorationKeepAliveTimer.setInterval(m_minimumGap);
+    m_explorationKeepAliveTimer.setSingleShot(true);
     connect(&m_explorationKeepAliveTimer, SIGNAL(timeout()), this, SLOT(explorationKeepAlive()));
 }
 
+/**
+ * The page is quiescent if no network request is waiting for data, no one-shot timer is due before the
+ * next exploration attempt, and no event action is waiting in the event action register.
+ *
+ * Repeating timers are ignored, a setInterval poll at or below the gap would never let the page become quiescent.
+ */
+bool AutoExplorer::isQuiescent() const
+{
+    if (WebCore::QNetworkReplyControllableFactory::getFactory()->numOpenNetworkSessions() != 0) {
+        return false;
+    }
+
+    WebCore::ThreadTimers& timers = WebCore::threadGlobalData().threadTimers();
+    return !timers.hasOneShotTimersDueWithin(m_minimumGap / 1000.0) && !timers.eventActionRegister()->hasWaitingEventActions();
+}
+
+/**
+ * Any pending work (regardless of when it is due) which could attach new event handlers.
+ */
+bool AutoExplorer::hasPendingWork() const
+{
+    if (WebCore::QNetworkReplyControllableFactory::getFactory()->numOpenNetworkSessions() != 0) {
+        return true;
+    }
+
+    WebCore::ThreadTimers& timers = WebCore::threadGlobalData().threadTimers();
+    return timers.hasOneShotTimers() || timers.eventActionRegister()->hasWaitingEventActions();
+}
+
 void AutoExplorer::explorationKeepAlive()
 {
-    if (m_numFramesLoading != 0) {
-        m_explorationKeepAliveTimer.start();
-        return;
+    if (m_numFramesLoading != 0 || !isQuiescent()) {
+        ++m_numNonQuiescentPolls;
+
+        if (m_numNonQuiescentPolls * m_minimumGap < m_maximumQuiescenceWait) {
+            m_explorationKeepAliveTimer.start();
+            return;
+        }
+
+        // Waited long enough, explore the page as it is
     }
 
-    bool success = m_frame->runAutomaticExploration();
+    m_numNonQuiescentPolls = 0;
 
-    if (success) {
+    // Fire a batch of event actions, the batch ends early if an event action leaves pending work behind
 
-        m_numFailedExplorationAttempts = 0;
+    unsigned int numExplored = 0;
+
+    while (numExplored < m_batchSize && m_numEventActionsExploredLimit > 0) {
+
+        if (!m_frame->runAutomaticExploration()) {
+            break;
+        }
+
+        ++numExplored;
         --m_numEventActionsExploredLimit;
 
+        if (!isQuiescent()) {
+            break;
+        }
+    }
+
+    if (numExplored > 0) {
+
+        m_numFailedExplorationAttempts = 0;
+
     } else {
 
         ++m_numFailedExplorationAttempts;
 
+        // Nothing to explore and nothing which could attach new event handlers
+        if (!hasPendingWork()) {
+            stop();
+            return;
+        }
+
     }
 
-    // Stop if we have reached our execution limit or failure limit
-    if (m_numEventActionsExploredLimit == 0 || m_numFailedExplorationAttempts == 10) { // > 2.5 seconds
+    // Stop if we have reached our execution limit or have been idle for too long
+    if (m_numEventActionsExploredLimit == 0 || m_numFailedExplorationAttempts * m_minimumGap >= m_idleTimeout) {
         stop();
         return;
     }
@@ -115,10 +184,12 @@ void AutoExplorer::explorationKeepAlive()
 }
 
 void AutoExplorer::stop() {
-    if (m_numFailedExplorationAttempts == 10) { // > 2.5 seconds
+    if (m_numFailedExplorationAttempts * m_minimumGap >= m_idleTimeout) {
         std::cerr << "Warning: Auto exploration not finished before stopping." << std::endl;
     }
 
+    m_explorationKeepAliveTimer.stop();
+
     disconnect(m_frame, 0, this, 0);
     emit done();
 }
@@ -144,6 +215,7 @@ void AutoExplorer::startAutoExploration()
 {
     connect(m_frame, SIGNAL(urlChanged(QUrl)), this, SLOT(differentUrl(QUrl)));
 
+    m_explorationKeepAliveTimer.setInterval(m_minimumGap);
     m_explorationKeepAliveTimer.start();
     m_explorationTimer.start();
 
@@ -26,14 +26,24 @@
 
 #include "qwebframe.h"
 
-#include <QMainWindow>
 #include <QTimer>
 
+#include "clientwindow.h"
+
 class AutoExplorer : public QObject {
     Q_OBJECT
 
 public:
-    AutoExplorer(QMainWindow* window, QWebFrame* frame);
+    AutoExplorer(ClientWindow* window, QWebFrame* frame);
+
+    // Minimum time between two exploration attempts, and the number of event actions fired back-to-back
+    // on a quiescent page before waiting again
+    void setMinimumGap(unsigned int ms) { m_minimumGap = ms; }
+    void setBatchSize(unsigned int size) { m_batchSize = size; }
+
+    // Pages polling the network or rescheduling timeouts may never become quiescent, the next event
+    // action is fired anyway after waiting this long
+    void setMaximumQuiescenceWait(unsigned int ms) { m_maximumQuiescenceWait = ms; }
 
 public slots:
     void explore(const QString& url, unsigned int preExploreTimeout, unsigned int explorationTimeout);
@@ -52,8 +62,10 @@ signals:
 private:
 
     void startAutoExploration();
+    bool isQuiescent() const;
+    bool hasPendingWork() const;
 
-    QMainWindow* m_window;
+    ClientWindow* m_window;
     QWebFrame* m_frame;
 
     unsigned int m_numFramesLoading;
@@ -65,6 +77,12 @@ private:
 
     unsigned int m_numEventActionsExploredLimit;
     unsigned int m_numFailedExplorationAttempts;
+    unsigned int m_numNonQuiescentPolls;
+
+    unsigned int m_minimumGap;
+    unsigned int m_batchSize;
+    unsigned int m_maximumQuiescenceWait;
+    unsigned int m_idleTimeout;
 };
 
 #endif
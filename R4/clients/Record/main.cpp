@@ -30,19 +30,27 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
+#include <QFile>
 #include <QString>
 #include <QTimer>
 #include <QNetworkProxy>
 #include <QNetworkCookie>
+#include <QWebSettings>
+
+#include <config.h>
 
 #include <WebCore/platform/ThreadTimers.h>
 #include <WebCore/platform/ThreadGlobalData.h>
 #include <JavaScriptCore/runtime/JSExportMacros.h>
 #include <WebCore/platform/network/qt/QNetworkReplyHandler.h>
+#include <WebCore/platform/graphics/ImageSource.h>
 #include <WebCore/platform/schedule/DefaultScheduler.h>
+#include <WebCore/storage/StorageSnapshot.h>
+#include <DumpRenderTreeSupportQt.h>
 #include <wtf/warningcollectorreport.h>
 
 #include "utils.h"
@@ -55,7 +63,8 @@
 
 /**
  * () ->
- *  schedule.data log.network.data log.random.data log.time.data ER_actionlog errors.log record.png
+ *  schedule.data log.network.data log.random.data log.time.data ER_actionlog errors.log [domhash.data] record.png
+ *  [log.storage.data storage.data]
  */
 class RecordClientApplication : public ClientApplication {
     Q_OBJECT
@@ -80,6 +89,16 @@ private:
 
     bool m_showWindow;
 
+    BaseWindow::ScreenshotMode m_screenshotMode;
+
+    WTF::WarningLogFormat m_errorLogFormat;
+    bool m_profileTraceBinary;
+    ActionLogFileFormat m_actionLogFormat;
+    bool m_actionLogSummary;
+
+    WebCore::QNetworkReplyControllableFactory::ChunkCoalescing m_networkChunkCoalescing;
+    qint64 m_networkChunkSize;
+
     WebCore::QNetworkReplyControllableFactoryLive* m_network;
     TimeProviderRecord* m_timeProvider;
     RandomProviderRecord* m_randomProvider;
@@ -101,18 +120,26 @@ RecordClientApplication::RecordClientApplication(int& argc, char** argv)
     , m_autoExploreTimout(30)
     , m_autoExplore(false)
     , m_showWindow(true)
+    , m_screenshotMode(BaseWindow::ScreenshotEncodeAlways)
+    , m_errorLogFormat(WTF::WarningLogText)
+    , m_profileTraceBinary(false)
+    , m_actionLogFormat(ActionLogRaw)
+    , m_actionLogSummary(false)
+    , m_networkChunkCoalescing(WebCore::QNetworkReplyControllableFactory::NO_COALESCING)
+    , m_networkChunkSize(0)
     , m_timeProvider(new TimeProviderRecord())
     , m_randomProvider(new RandomProviderRecord())
     //, m_scheduler(new SpecificationScheduler(m_network))
     , m_scheduler(new WebCore::DefaultScheduler())
     , m_autoExplorer(new AutoExplorer(m_window, m_window->page()->mainFrame()))
 {
-    QObject::connect(m_window, SIGNAL(sigOnCloseEvent()), this, SLOT(slOnCloseEvent()));
+    QObject::connect(m_window->object(), SIGNAL(sigOnCloseEvent()), this, SLOT(slOnCloseEvent()));
     handleUserOptions();
 
     // Network
 
     m_network = new WebCore::QNetworkReplyControllableFactoryLive();
+    m_network->setChunkCoalescing(m_networkChunkCoalescing, m_networkChunkSize);
     WebCore::QNetworkReplyControllableFactory::setFactory(m_network);
 
     // Random
@@ -127,6 +154,10 @@ RecordClientApplication::RecordClientApplication(int& argc, char** argv)
 
     WebCore::ThreadTimers::setScheduler(m_scheduler);
 
+    // Stream the schedule to disk while recording, such that it survives a crash
+
+    WebCore::threadGlobalData().threadTimers().eventActionRegister()->dispatchHistory()->setPath((m_outdir + "/schedule.data.partial").toStdString());
+
     // Cookies support
 
     WebCore::QNetworkSnapshotCookieJar* cookieJar = new WebCore::QNetworkSnapshotCookieJar(this);
@@ -167,7 +198,27 @@ void RecordClientApplication::handleUserOptions()
                  << "[-autoexplore]"
                  << "[-autoexplore-timeout]"
                  << "[-pre-autoexplore-timeout]"
+                 << "[-autoexplore-min-gap MS]"
+                 << "[-autoexplore-max-wait MS]"
+                 << "[-autoexplore-batch N]"
+                 << "[-autoexplore-round-robin]"
                  << "[-hidewindow]"
+                 << "[-headless]"
+                 << "[-suppress-painting]"
+                 << "[-metadata-only-images]"
+                 << "[-stop-image-animations]"
+                 << "[-in-memory-storage]"
+                 << "[-storage-snapshot FILE]"
+                 << "[-screenshot-deferred]"
+                 << "[-binary-error-log]"
+                 << "[-warning-limit N]"
+                 << "[-profile-trace json|binary]"
+                 << "[-encoded-actionlog]"
+                 << "[-range-actionlog]"
+                 << "[-actionlog-summary]"
+                 << "[-domhash-log]"
+                 << "[-network-chunk-size BYTES]"
+                 << "[-network-chunk-tokens]"
                  << "[-verbose]"
                  << "[-proxy URL:PORT]"
                  << "[-cookie KEY=VALUE]"
@@ -204,6 +255,40 @@ void RecordClientApplication::handleUserOptions()
         this->m_window->page()->ignoreMouseMove(true);
     }
 
+    // Keep layout exact but skip painting, only the final screenshot is painted
+    int suppressPaintingIndex = args.indexOf("-suppress-painting");
+    if (suppressPaintingIndex != -1) {
+        m_window->page()->settings()->setAttribute(QWebSettings::PaintingSuppressed, true);
+    }
+
+    // Only decode image headers until a frame is painted or its pixels are read
+    int metadataOnlyImagesIndex = args.indexOf("-metadata-only-images");
+    if (metadataOnlyImagesIndex != -1) {
+        WebCore::ImageSource::setMetadataOnlyDecoding(true);
+    }
+
+    // Keep animated images on their first frame
+    int stopImageAnimationsIndex = args.indexOf("-stop-image-animations");
+    if (stopImageAnimationsIndex != -1) {
+        WebCore::ImageSource::setAnimationsStopped(true);
+    }
+
+    // Keep localStorage and sessionStorage in memory, starting from the given snapshot (or empty)
+    int inMemoryStorageIndex = args.indexOf("-in-memory-storage");
+    int storageSnapshotIndex = args.indexOf("-storage-snapshot");
+    if (inMemoryStorageIndex != -1 || storageSnapshotIndex != -1) {
+        WebCore::StorageSnapshot::setEnabled(true);
+        m_window->page()->settings()->setAttribute(QWebSettings::LocalStorageEnabled, true);
+    }
+
+    if (storageSnapshotIndex != -1) {
+        QString storageSnapshotPath = takeOptionValue(&args, storageSnapshotIndex);
+        if (!WebCore::StorageSnapshot::load(storageSnapshotPath)) {
+            qDebug() << "Could not load storage snapshot" << storageSnapshotPath;
+            std::exit(1);
+        }
+    }
+
     int outdirIndex = args.indexOf("-out_dir");
     if (outdirIndex != -1) {
          m_outdir = takeOptionValue(&args, outdirIndex);
@@ -219,6 +304,26 @@ void RecordClientApplication::handleUserOptions()
         m_autoExplorePreTimout = takeOptionValue(&args, preTimeoutIndex).toInt();
     }
 
+    int minGapIndex = args.indexOf("-autoexplore-min-gap");
+    if (minGapIndex != -1) {
+        m_autoExplorer->setMinimumGap(takeOptionValue(&args, minGapIndex).toUInt());
+    }
+
+    int maxWaitIndex = args.indexOf("-autoexplore-max-wait");
+    if (maxWaitIndex != -1) {
+        m_autoExplorer->setMaximumQuiescenceWait(takeOptionValue(&args, maxWaitIndex).toUInt());
+    }
+
+    int batchIndex = args.indexOf("-autoexplore-batch");
+    if (batchIndex != -1) {
+        m_autoExplorer->setBatchSize(std::max(1u, takeOptionValue(&args, batchIndex).toUInt()));
+    }
+
+    int roundRobinIndex = args.indexOf("-autoexplore-round-robin");
+    if (roundRobinIndex != -1) {
+        getEventAttachLog()->setPullPolicy(EventAttachLog::PULL_ROUND_ROBIN);
+    }
+
     int autoexploreIndex = args.indexOf("-autoexplore");
     if (autoexploreIndex != -1) {
         m_autoExplore = true;
@@ -229,6 +334,65 @@ void RecordClientApplication::handleUserOptions()
         m_showWindow = false;
     }
 
+    // Coalesce network data into chunks of (at least) N bytes, optionally ending at a '>' or newline
+    int networkChunkSizeIndex = args.indexOf("-network-chunk-size");
+    if (networkChunkSizeIndex != -1) {
+        m_networkChunkSize = takeOptionValue(&args, networkChunkSizeIndex).toLongLong();
+        m_networkChunkCoalescing = WebCore::QNetworkReplyControllableFactory::SIZE_COALESCING;
+    }
+
+    int networkChunkTokensIndex = args.indexOf("-network-chunk-tokens");
+    if (networkChunkTokensIndex != -1 && m_networkChunkSize > 0) {
+        m_networkChunkCoalescing = WebCore::QNetworkReplyControllableFactory::TOKEN_COALESCING;
+    }
+
+    int binaryErrorLogIndex = args.indexOf("-binary-error-log");
+    if (binaryErrorLogIndex != -1) {
+        m_errorLogFormat = WTF::WarningLogBinary;
+    }
+
+    // Only keep the details of the first N warnings of each kind (0, the default, keeps all)
+    int warningLimitIndex = args.indexOf("-warning-limit");
+    if (warningLimitIndex != -1) {
+        WTF::WarningCollectorSetRateLimit(takeOptionValue(&args, warningLimitIndex).toUInt());
+    }
+
+    // Record a per event action profiling trace (profile.trace.json or profile.trace)
+    int profileTraceIndex = args.indexOf("-profile-trace");
+    if (profileTraceIndex != -1) {
+        m_profileTraceBinary = takeOptionValue(&args, profileTraceIndex) == "binary";
+        WebCore::threadGlobalData().threadTimers().eventActionRegister()->setProfiling(true);
+    }
+
+    // Write ER_actionlog in the compact encoding (convert it with actionlog-convert before race detection)
+    int encodedActionLogIndex = args.indexOf("-encoded-actionlog");
+    if (encodedActionLogIndex != -1) {
+        m_actionLogFormat = ActionLogEncoded;
+    }
+
+    // Log bulk array accesses as single range commands (convert ER_actionlog with actionlog-convert -raw before race detection)
+    int rangeActionLogIndex = args.indexOf("-range-actionlog");
+    if (rangeActionLogIndex != -1) {
+        ActionLogRangeCommands(true);
+    }
+
+    // Write a summary of the memory accesses next to ER_actionlog (ER_summary and ER_summary.json)
+    int actionLogSummaryIndex = args.indexOf("-actionlog-summary");
+    if (actionLogSummaryIndex != -1) {
+        m_actionLogSummary = true;
+    }
+
+    // Log the DOM content hash after each event action (domhash.data)
+    int contentHashLogIndex = args.indexOf("-domhash-log");
+    if (contentHashLogIndex != -1) {
+        setContentHashLogEnabled(true);
+    }
+
+    int screenshotDeferredIndex = args.indexOf("-screenshot-deferred");
+    if (screenshotDeferredIndex != -1) {
+        m_screenshotMode = BaseWindow::ScreenshotEncodeDeferred;
+    }
+
     int cookieIndex = 0;
     while ((cookieIndex = args.indexOf("-cookie", cookieIndex)) != -1) {
         QString cookieRaw = takeOptionValue(&args, cookieIndex);
@@ -266,6 +430,7 @@ void RecordClientApplication::snapshotState(QString id) {
     QString outErLogPath = m_outdir + "/" + id + "ER_actionlog";
     QString logErrorsPath = m_outdir + "/" + id + "errors.log";
     QString screenshotPath = m_outdir + "/" + id + "screenshot.png";
+    QString outContentHashPath = m_outdir + "/" + id + "domhash.data";
 
     // HTML Hash & scheduler state
 
@@ -290,24 +455,20 @@ void RecordClientApplication::snapshotState(QString id) {
 //        break;
 //    }
 
-    uint htmlHash = 0; // this will overflow as we are using it, but that is as exptected
-
-    QList<QWebFrame*> queue;
-    queue.append(m_window->page()->mainFrame());
-
-    while (!queue.empty()) {
-        QWebFrame* current = queue.takeFirst();
-        htmlHash += qHash(current->toHtml());
-        queue.append(current->childFrames());
-    }
-
-    statusfile << "HTML-hash: " << htmlHash << std::endl;
+    statusfile << "HTML-hash: " << pageContentHash() << std::endl;
+    statusfile << windowStatus().toStdString();
+    // WebERA: GC pause times, the bucket limits are 0.5ms doubling up to 1s
+    statusfile << DumpRenderTreeSupportQt::garbageCollectorStatistics().toStdString();
 
     statusfile.close();
 
     // happens before
 
-    ActionLogSave(outErLogPath.toStdString());
+    ActionLogSave(outErLogPath.toStdString(), m_actionLogFormat);
+
+    if (m_actionLogSummary) {
+        ActionLogSaveSummary((m_outdir + "/" + id + "ER_summary").toStdString());
+    }
 
     // schedule
 
@@ -316,6 +477,19 @@ void RecordClientApplication::snapshotState(QString id) {
     WebCore::threadGlobalData().threadTimers().eventActionRegister()->dispatchHistory()->serialize(schedulefile);
     schedulefile.close();
 
+    QFile::remove(QString::fromStdString(WebCore::threadGlobalData().threadTimers().eventActionRegister()->dispatchHistory()->path()));
+
+    // profiling trace
+
+    WebCore::EventActionProfiler* profiler = WebCore::threadGlobalData().threadTimers().eventActionRegister()->profiler();
+    if (profiler) {
+        if (m_profileTraceBinary) {
+            profiler->writeBinary((m_outdir + "/" + id + "profile.trace").toStdString());
+        } else {
+            profiler->writeChromeTrace((m_outdir + "/" + id + "profile.trace.json").toStdString());
+        }
+    }
+
     // network
 
     m_network->writeNetworkFile(outLogNetworkPath);
@@ -325,12 +499,31 @@ void RecordClientApplication::snapshotState(QString id) {
     m_timeProvider->writeLogFile(outLogTimePath);
     m_randomProvider->writeLogFile(outLogRandomPath);
 
+    // storage, the replays start from the same snapshot
+
+    if (WebCore::StorageSnapshot::isEnabled()) {
+        WebCore::StorageSnapshot::saveInitialState(m_outdir + "/" + id + "log.storage.data");
+        WebCore::StorageSnapshot::saveCurrentState(m_outdir + "/" + id + "storage.data");
+    }
+
+    // DOM content hash after each event action
+
+    if (contentHashLogEnabled()) {
+        writeContentHashLogFile(outContentHashPath);
+    }
+
     // Screenshot
 
-    m_window->takeScreenshot(screenshotPath);
+    quint64 screenshotSimilarityHash = 0;
+    quint64 screenshotHash = m_window->takeScreenshot(screenshotPath, m_screenshotMode, 0, &screenshotSimilarityHash);
+
+    statusfile.open(outStatusPath.toStdString().c_str(), std::ios_base::app);
+    statusfile << "Screenshot-hash: " << screenshotHash << std::endl;
+    statusfile << "Screenshot-dhash: " << screenshotSimilarityHash << std::endl;
+    statusfile.close();
 
     // Errors
-    WTF::WarningCollecterWriteToLogFile(logErrorsPath.toStdString());
+    WTF::WarningCollecterWriteToLogFile(logErrorsPath.toStdString(), m_errorLogFormat);
 
 
 }
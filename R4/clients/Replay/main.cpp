@@ -39,13 +39,20 @@
 #include <QTimer>
 #include <QNetworkProxy>
 #include <QString>
+#include <QFile>
+#include <QRegExp>
+#include <QWebSettings>
 
 #include <config.h>
 
 #include <WebCore/platform/ThreadTimers.h>
 #include <WebCore/platform/ThreadGlobalData.h>
 #include <JavaScriptCore/runtime/JSExportMacros.h>
+#include <JavaScriptCore/parser/PersistentSourceProviderCache.h>
 #include <WebCore/platform/network/qt/QNetworkReplyHandler.h>
+#include <WebCore/platform/graphics/ImageSource.h>
+#include <WebCore/storage/StorageSnapshot.h>
+#include <DumpRenderTreeSupportQt.h>
 #include <wtf/warningcollector.h>
 #include <wtf/warningcollectorreport.h>
 
@@ -64,6 +71,7 @@ public:
 private:
     void handleUserOptions();
     void snapshotState(QString id);
+    bool readScreenshotHash(QString statusPath, quint64* hash);
 
     QString m_url;
     QString m_outdir;
@@ -72,6 +80,7 @@ private:
     QString m_logNetworkPath;
     QString m_logRandomPath;
     QString m_logTimePath;
+    QString m_logStoragePath;
 
     ReplayScheduler* m_scheduler;
     TimeProviderReplay* m_timeProvider;
@@ -81,6 +90,16 @@ private:
     bool m_isStopping;
     bool m_showWindow;
 
+    BaseWindow::ScreenshotMode m_screenshotMode;
+    quint64 m_screenshotBaseHash;
+
+    WTF::WarningLogFormat m_errorLogFormat;
+    bool m_profileTraceBinary;
+    ActionLogFileFormat m_actionLogFormat;
+    bool m_actionLogSummary;
+
+    bool m_useNetworkService;
+
     int m_schedulerTimeout;
 
 public slots:
@@ -89,14 +108,23 @@ public slots:
 };
 
 /**
- * schedule.data log.network.data log.random.data log.time.data ->
- *  schedule.out.data log.network.out.data log.random.out.data log.time.out.data ER_actionlog errors.log replay.png
+ * schedule.data log.network.data log.random.data log.time.data [log.storage.data] ->
+ *  schedule.out.data log.network.out.data log.random.out.data log.time.out.data ER_actionlog errors.log [domhash.data] replay.png
+ *  eventactionids.data
+ *  [log.storage.out.data storage.out.data]
  */
 ReplayClientApplication::ReplayClientApplication(int& argc, char** argv)
     : ClientApplication(argc, argv)
     , m_outdir("/tmp/")
     , m_isStopping(false)
     , m_showWindow(true)
+    , m_screenshotMode(BaseWindow::ScreenshotEncodeAlways)
+    , m_screenshotBaseHash(0)
+    , m_errorLogFormat(WTF::WarningLogText)
+    , m_profileTraceBinary(false)
+    , m_actionLogFormat(ActionLogRaw)
+    , m_actionLogSummary(false)
+    , m_useNetworkService(false)
     , m_schedulerTimeout(20000)
 {
 
@@ -104,7 +132,7 @@ ReplayClientApplication::ReplayClientApplication(int& argc, char** argv)
 
     // Network
 
-    m_network = new QNetworkReplyControllableFactoryReplay(m_logNetworkPath);
+    m_network = new QNetworkReplyControllableFactoryReplay(m_logNetworkPath, m_useNetworkService);
 
     WebCore::QNetworkReplyControllableFactory::setFactory(m_network);
     m_window->page()->networkAccessManager()->setCookieJar(new WebCore::QNetworkSnapshotCookieJar(this));
@@ -126,6 +154,10 @@ ReplayClientApplication::ReplayClientApplication(int& argc, char** argv)
 
     WebCore::ThreadTimers::setScheduler(m_scheduler);
 
+    // Stream the executed schedule to disk while replaying, such that it survives a crash
+
+    WebCore::threadGlobalData().threadTimers().eventActionRegister()->dispatchHistory()->setPath((m_outdir + "/out.schedule.data.partial").toStdString());
+
     // Replay-mode setup
 
     m_window->page()->enableReplayUserEventMode();
@@ -147,6 +179,22 @@ void ReplayClientApplication::handleUserOptions()
     if (args.contains(QString::fromAscii("-help")) || args.size() == 1) {
         qDebug() << "Usage:" << m_programName.toLatin1().data()
                  << "[-hidewindow]"
+                 << "[-headless]"
+                 << "[-suppress-painting]"
+                 << "[-metadata-only-images]"
+                 << "[-stop-image-animations]"
+                 << "[-screenshot-deferred]"
+                 << "[-screenshot-if-changed]"
+                 << "[-binary-error-log]"
+                 << "[-warning-limit N]"
+                 << "[-profile-trace json|binary]"
+                 << "[-encoded-actionlog]"
+                 << "[-range-actionlog]"
+                 << "[-actionlog-summary]"
+                 << "[-domhash-log]"
+                 << "[-network-service]"
+                 << "[-in-memory-storage]"
+                 << "[-js-cache DIR]"
                  << "[-timeout]"
                  << "[-out_dir]"
                  << "[-in_dir]"
@@ -179,6 +227,107 @@ void ReplayClientApplication::handleUserOptions()
     m_logNetworkPath = indir + "/log.network.data";
     m_logTimePath = indir + "/log.time.data";
     m_logRandomPath = indir + "/log.random.data";
+    m_logStoragePath = indir + "/log.storage.data";
+
+    int screenshotDeferredIndex = args.indexOf("-screenshot-deferred");
+    if (screenshotDeferredIndex != -1) {
+        m_screenshotMode = BaseWindow::ScreenshotEncodeDeferred;
+    }
+
+    // Only encode the screenshot if it differs from the screenshot of the recording (in_dir/status.data)
+    int screenshotIfChangedIndex = args.indexOf("-screenshot-if-changed");
+    if (screenshotIfChangedIndex != -1 && readScreenshotHash(indir + "/status.data", &m_screenshotBaseHash)) {
+        m_screenshotMode = BaseWindow::ScreenshotEncodeIfChanged;
+    }
+
+    // Lay out the page with the viewport size of the recording
+    if (!matchRecordedWindow(indir + "/status.data")) {
+        std::cerr << "The recording in " << indir.toStdString() << " was made with -headless, replay it with -headless" << std::endl;
+        std::exit(1);
+    }
+
+    // Use the network log loaded by a running network snapshot service (see NetworkService)
+    int networkServiceIndex = args.indexOf("-network-service");
+    if (networkServiceIndex != -1) {
+        m_useNetworkService = true;
+    }
+
+    // Keep layout exact but skip painting, only the final screenshot is painted
+    int suppressPaintingIndex = args.indexOf("-suppress-painting");
+    if (suppressPaintingIndex != -1) {
+        m_window->page()->settings()->setAttribute(QWebSettings::PaintingSuppressed, true);
+    }
+
+    // Only decode image headers until a frame is painted or its pixels are read
+    int metadataOnlyImagesIndex = args.indexOf("-metadata-only-images");
+    if (metadataOnlyImagesIndex != -1) {
+        WebCore::ImageSource::setMetadataOnlyDecoding(true);
+    }
+
+    // Keep animated images on their first frame
+    int stopImageAnimationsIndex = args.indexOf("-stop-image-animations");
+    if (stopImageAnimationsIndex != -1) {
+        WebCore::ImageSource::setAnimationsStopped(true);
+    }
+
+    // Keep localStorage and sessionStorage in memory, starting from the snapshot of the recording (or empty)
+    int inMemoryStorageIndex = args.indexOf("-in-memory-storage");
+    if (inMemoryStorageIndex != -1) {
+        WebCore::StorageSnapshot::setEnabled(true);
+        if (QFile::exists(m_logStoragePath) && !WebCore::StorageSnapshot::load(m_logStoragePath)) {
+            qDebug() << "Could not load storage snapshot" << m_logStoragePath;
+            std::exit(1);
+        }
+        m_window->page()->settings()->setAttribute(QWebSettings::LocalStorageEnabled, true);
+    }
+
+    // Share the parser function cache of the site's scripts between runs (one directory per site)
+    int jsCacheIndex = args.indexOf("-js-cache");
+    if (jsCacheIndex != -1) {
+        JSC::PersistentSourceProviderCache::setDirectory(takeOptionValue(&args, jsCacheIndex));
+    }
+
+    int binaryErrorLogIndex = args.indexOf("-binary-error-log");
+    if (binaryErrorLogIndex != -1) {
+        m_errorLogFormat = WTF::WarningLogBinary;
+    }
+
+    // Only keep the details of the first N warnings of each kind (0, the default, keeps all)
+    int warningLimitIndex = args.indexOf("-warning-limit");
+    if (warningLimitIndex != -1) {
+        WTF::WarningCollectorSetRateLimit(takeOptionValue(&args, warningLimitIndex).toUInt());
+    }
+
+    // Record a per event action profiling trace (profile.trace.json or profile.trace)
+    int profileTraceIndex = args.indexOf("-profile-trace");
+    if (profileTraceIndex != -1) {
+        m_profileTraceBinary = takeOptionValue(&args, profileTraceIndex) == "binary";
+        WebCore::threadGlobalData().threadTimers().eventActionRegister()->setProfiling(true);
+    }
+
+    // Write ER_actionlog in the compact encoding (convert it with actionlog-convert before race detection)
+    int encodedActionLogIndex = args.indexOf("-encoded-actionlog");
+    if (encodedActionLogIndex != -1) {
+        m_actionLogFormat = ActionLogEncoded;
+    }
+
+    // Log bulk array accesses as single range commands (convert ER_actionlog with actionlog-convert -raw before race detection)
+    int rangeActionLogIndex = args.indexOf("-range-actionlog");
+    if (rangeActionLogIndex != -1) {
+        ActionLogRangeCommands(true);
+    }
+
+    // Write a summary of the memory accesses next to ER_actionlog (ER_summary and ER_summary.json)
+    int actionLogSummaryIndex = args.indexOf("-actionlog-summary");
+    if (actionLogSummaryIndex != -1) {
+        m_actionLogSummary = true;
+    }
+
+    // Log the DOM content hash after each event action (domhash.data)
+    int contentHashLogIndex = args.indexOf("-domhash-log");
+    if (contentHashLogIndex != -1) {
+        setContentHashLogEnabled(true);
+    }
 
     WebCore::threadGlobalData().threadTimers().eventActionRegister()->setVerbose(false);
     int verboseIndex = args.indexOf("-verbose");
@@ -232,6 +381,26 @@ void ReplayClientApplication::handleUserOptions()
     }
 }
 
+bool ReplayClientApplication::readScreenshotHash(QString statusPath, quint64* hash)
+{
+    QFile fp(statusPath);
+    if (!fp.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    QRegExp pattern("^Screenshot-hash: ([0-9]+)");
+
+    while (!fp.atEnd()) {
+        QString line = QString::fromAscii(fp.readLine());
+        if (pattern.indexIn(line) != -1) {
+            *hash = pattern.cap(1).toULongLong();
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void ReplayClientApplication::slTimeout() {
     m_scheduler->timeout();
 }
@@ -248,6 +417,8 @@ void ReplayClientApplication::snapshotState(QString id) {
     QString outErLogPath = m_outdir + "/" + id + "ER_actionlog";
     QString logErrorsPath = m_outdir + "/" + id + "errors.log";
     QString screenshotPath = m_outdir + "/" + id + "screenshot.png";
+    QString outContentHashPath = m_outdir + "/" + id + "domhash.data";
+    QString outEventActionIdsPath = m_outdir + "/" + id + "eventactionids.data";
 
     // HTML Hash & scheduler state
 
@@ -272,24 +443,20 @@ void ReplayClientApplication::snapshotState(QString id) {
         break;
     }
 
-    uint htmlHash = 0; // this will overflow as we are using it, but that is as exptected
-
-    QList<QWebFrame*> queue;
-    queue.append(m_window->page()->mainFrame());
-
-    while (!queue.empty()) {
-        QWebFrame* current = queue.takeFirst();
-        htmlHash += qHash(current->toHtml());
-        queue.append(current->childFrames());
-    }
-
-    statusfile << "HTML-hash: " << htmlHash << std::endl;
+    statusfile << "HTML-hash: " << pageContentHash() << std::endl;
+    statusfile << windowStatus().toStdString();
+    // WebERA: GC pause times, the bucket limits are 0.5ms doubling up to 1s
+    statusfile << DumpRenderTreeSupportQt::garbageCollectorStatistics().toStdString();
 
     statusfile.close();
 
     // happens before
 
-    ActionLogSave(outErLogPath.toStdString());
+    ActionLogSave(outErLogPath.toStdString(), m_actionLogFormat);
+
+    if (m_actionLogSummary) {
+        ActionLogSaveSummary((m_outdir + "/" + id + "ER_summary").toStdString());
+    }
 
     // schedule
 
@@ -298,6 +465,33 @@ void ReplayClientApplication::snapshotState(QString id) {
     WebCore::threadGlobalData().threadTimers().eventActionRegister()->dispatchHistory()->serialize(schedulefile);
     schedulefile.close();
 
+    QFile::remove(QString::fromStdString(WebCore::threadGlobalData().threadTimers().eventActionRegister()->dispatchHistory()->path()));
+
+    // event action ids (the id of each event action of the input schedule in this replay, "<original> <new>")
+
+    std::ofstream eventactionidsfile;
+    eventactionidsfile.open(outEventActionIdsPath.toStdString().c_str());
+
+    const std::map<int, int>& eventActionIds = WebCore::threadGlobalData().threadTimers().eventActionRegister()->originalToNewEventActionIds();
+    for (std::map<int, int>::const_iterator it = eventActionIds.begin(); it != eventActionIds.end(); ++it) {
+        if (it->first >= 0) {
+            eventactionidsfile << it->first << " " << it->second << std::endl;
+        }
+    }
+
+    eventactionidsfile.close();
+
+    // profiling trace
+
+    WebCore::EventActionProfiler* profiler = WebCore::threadGlobalData().threadTimers().eventActionRegister()->profiler();
+    if (profiler) {
+        if (m_profileTraceBinary) {
+            profiler->writeBinary((m_outdir + "/" + id + "profile.trace").toStdString());
+        } else {
+            profiler->writeChromeTrace((m_outdir + "/" + id + "profile.trace.json").toStdString());
+        }
+    }
+
     // network
 
     m_network->writeNetworkFile(outLogNetworkPath);
@@ -307,12 +501,31 @@ void ReplayClientApplication::snapshotState(QString id) {
     m_timeProvider->writeLogFile(outLogTimePath);
     m_randomProvider->writeLogFile(outLogRandomPath);
 
+    // storage
+
+    if (WebCore::StorageSnapshot::isEnabled()) {
+        WebCore::StorageSnapshot::saveInitialState(m_outdir + "/" + id + "log.storage.data");
+        WebCore::StorageSnapshot::saveCurrentState(m_outdir + "/" + id + "storage.data");
+    }
+
+    // DOM content hash after each event action
+
+    if (contentHashLogEnabled()) {
+        writeContentHashLogFile(outContentHashPath);
+    }
+
     // Screenshot
 
-    m_window->takeScreenshot(screenshotPath);
+    quint64 screenshotSimilarityHash = 0;
+    quint64 screenshotHash = m_window->takeScreenshot(screenshotPath, m_screenshotMode, m_screenshotBaseHash, &screenshotSimilarityHash);
+
+    statusfile.open(outStatusPath.toStdString().c_str(), std::ios_base::app);
+    statusfile << "Screenshot-hash: " << screenshotHash << std::endl;
+    statusfile << "Screenshot-dhash: " << screenshotSimilarityHash << std::endl;
+    statusfile.close();
 
     // Errors
-    WTF::WarningCollecterWriteToLogFile(logErrorsPath.toStdString());
+    WTF::WarningCollecterWriteToLogFile(logErrorsPath.toStdString(), m_errorLogFormat);
 
 }
 
@@ -358,18 +571,7 @@ void ReplayClientApplication::slSchedulerDone()
             break;
         }
 
-        uint htmlHash = 0; // this will overflow as we are using it, but that is as exptected
-
-        QList<QWebFrame*> queue;
-        queue.append(m_window->page()->mainFrame());
-
-        while (!queue.empty()) {
-            QWebFrame* current = queue.takeFirst();
-            htmlHash += qHash(current->toHtml());
-            queue.append(current->childFrames());
-        }
-
-        std::cout << "HTML-hash: " << htmlHash << std::endl;
+        std::cout << "HTML-hash: " << pageContentHash() << std::endl;
 
         m_window->close();
         m_isStopping = true;
@@ -33,6 +33,7 @@
 #include <wtf/warningcollectorreport.h>
 
 #include "fuzzyurl.h"
+#include "networksnapshotsegment.h"
 
 #include "network.h"
 
@@ -52,30 +53,63 @@ QNetworkReplyControllableReplay::QNetworkReplyControllableReplay(WebCore::QNetwo
 
 }
 
-QNetworkReplyControllableFactoryReplay::QNetworkReplyControllableFactoryReplay(QString logNetworkPath)
+QNetworkReplyControllableFactoryReplay::QNetworkReplyControllableFactoryReplay(QString logNetworkPath, bool useService)
     : QNetworkReplyControllableFactory()
     , m_mode(STRICT)
+    , m_useSharedSnapshots(false)
 {
+    // Share the snapshots with other replays of the same recording if the network snapshot service is running
+
+    if (useService) {
+
+        if (NetworkSnapshotSegment::attach(&m_sharedSnapshots, logNetworkPath)) {
+
+            m_useSharedSnapshots = true;
+
+            QList<NetworkSnapshotSegment::IndexEntry> index = NetworkSnapshotSegment::index(&m_sharedSnapshots);
+            foreach (const NetworkSnapshotSegment::IndexEntry& entry, index) {
+                RecordedSnapshot snapshot = { 0, entry.second };
+                addSnapshot(entry.first, snapshot);
+            }
+
+            return;
+        }
+
+        std::cerr << "Warning: No network snapshot service running for " << logNetworkPath.toStdString() << ", reading the network log" << std::endl;
+    }
+
     QFile fp(logNetworkPath);
     fp.open(QIODevice::ReadOnly);
 
     while (!fp.atEnd()) {
-        WebCore::QNetworkReplyInitialSnapshot* snapshot = WebCore::QNetworkReplyInitialSnapshot::deserialize(&fp);
+        RecordedSnapshot snapshot = { WebCore::QNetworkReplyInitialSnapshot::deserialize(&fp), 0 };
+        addSnapshot(snapshot.snapshot->getUrl().toString(), snapshot);
+    }
 
-        QString url = snapshot->getUrl().toString();
+    fp.close();
+}
 
-        SnapshotMap::iterator iter = m_snapshots.find(url);
-        if (iter == m_snapshots.end()) {
-            SnapshotList* list = new SnapshotList();
-            list->append(snapshot);
-            m_snapshots.insert(url, list);
-        } else {
-            (*iter)->append(snapshot);
-        }
+void QNetworkReplyControllableFactoryReplay::addSnapshot(const QString& url, const RecordedSnapshot& snapshot)
+{
+    SnapshotMap::iterator iter = m_snapshots.find(url);
+    if (iter == m_snapshots.end()) {
+        SnapshotList* list = new SnapshotList();
+        list->append(snapshot);
+        m_snapshots.insert(url, list);
+    } else {
+        (*iter)->append(snapshot);
+    }
+}
+
+WebCore::QNetworkReplyInitialSnapshot* QNetworkReplyControllableFactoryReplay::takeSnapshot(SnapshotList* list)
+{
+    RecordedSnapshot recorded = list->takeFirst();
 
+    if (m_useSharedSnapshots) {
+        return NetworkSnapshotSegment::snapshot(&m_sharedSnapshots, recorded.segmentEntry);
     }
 
-    fp.close();
+    return recorded.snapshot;
 }
 
 WebCore::QNetworkReplyControllable* QNetworkReplyControllableFactoryReplay::construct(QNetworkReply* reply, QObject* parent)
@@ -92,7 +126,7 @@ WebCore::QNetworkReplyControllable* QNetworkReplyControllableFactoryReplay::cons
         // It could be that we have replayed all known instances of this URL
         // If that is the case let it flow through the relaxedReplayMode logic or error out
         if (!(*iter)->isEmpty()) {
-            return new QNetworkReplyControllableReplay(this, reply, (*iter)->takeFirst(), parent);
+            return new QNetworkReplyControllableReplay(this, reply, takeSnapshot(*iter), parent);
         }
     }
 
@@ -105,8 +139,7 @@ WebCore::QNetworkReplyControllable* QNetworkReplyControllableFactoryReplay::cons
         FuzzyUrlMatcher matcher(reply->url());
 
         unsigned int bestScore = 0;
-        WebCore::QNetworkReplyInitialSnapshot* bestSnapshot = NULL;
-        SnapshotMap::const_iterator bestList;
+        SnapshotMap::const_iterator bestList = m_snapshots.constEnd();
 
         iter = m_snapshots.begin();
         for (; iter != m_snapshots.end(); iter++) {
@@ -115,20 +148,21 @@ WebCore::QNetworkReplyControllable* QNetworkReplyControllableFactoryReplay::cons
                 continue; // skip emtpy lists
             }
 
-            WebCore::QNetworkReplyInitialSnapshot* snapshot = (*iter)->first();
+            // All snapshots in a list share the URL of the key
 
-            unsigned int score = matcher.score(snapshot->getUrl());
+            unsigned int score = matcher.score(QUrl(iter.key()));
 
             if (score > bestScore) {
                 bestScore = score;
-                bestSnapshot = snapshot;
                 bestList = iter;
             }
         }
 
-        if (bestSnapshot != NULL) {
+        if (bestList != m_snapshots.constEnd()) {
             // We found a fuzzy match
 
+            WebCore::QNetworkReplyInitialSnapshot* bestSnapshot = takeSnapshot(*bestList);
+
             std::stringstream details;
             details << "Network request " << reply->url().toString().toStdString() << " fuzzy matched with " << bestSnapshot->getUrl().toString().toStdString() << ".";
 
@@ -136,7 +170,6 @@ WebCore::QNetworkReplyControllable* QNetworkReplyControllableFactoryReplay::cons
 
             std::cout << "Fuzzy match found (" << bestSnapshot->getUrl().toString().toStdString() << ")" << std::endl;
 
-            (*bestList)->pop_front();
             return new QNetworkReplyControllableReplay(this, reply, bestSnapshot, parent);
         }
 
@@ -28,6 +28,7 @@
 #define NETWORK_H
 
 #include <QMultiHash>
+#include <QSharedMemory>
 
 #include <JavaScriptCore/runtime/JSExportMacros.h>
 #include <WebCore/platform/network/qt/QNetworkReplyHandler.h>
@@ -49,7 +50,8 @@ class QNetworkReplyControllableFactoryReplay : public WebCore::QNetworkReplyCont
 {
 
 public:
-    QNetworkReplyControllableFactoryReplay(QString logNetworkPath);
+    // If useService is set, the snapshots are taken from a running network snapshot service if there is one
+    QNetworkReplyControllableFactoryReplay(QString logNetworkPath, bool useService = false);
 
     WebCore::QNetworkReplyControllable* construct(QNetworkReply* reply, QObject* parent=0);
 
@@ -58,10 +60,23 @@ public:
     }
 
 private:
-    typedef QList<WebCore::QNetworkReplyInitialSnapshot*> SnapshotList;
+    // A recorded snapshot, snapshots served by the network snapshot service are only deserialized when used
+    struct RecordedSnapshot {
+        WebCore::QNetworkReplyInitialSnapshot* snapshot;
+        quint32 segmentEntry;
+    };
+
+    typedef QList<RecordedSnapshot> SnapshotList;
+
+    void addSnapshot(const QString& url, const RecordedSnapshot& snapshot);
+    WebCore::QNetworkReplyInitialSnapshot* takeSnapshot(SnapshotList* list);
+
     typedef QHash<QString, SnapshotList*> SnapshotMap;
     SnapshotMap m_snapshots;
     ReplayMode m_mode;
+
+    QSharedMemory m_sharedSnapshots; // attached for the lifetime of the snapshots
+    bool m_useSharedSnapshots;
 };
 
 #endif // NETWORK_H
@@ -53,11 +53,7 @@ ReplayScheduler::ReplayScheduler(const std::string& schedulePath, QNetworkReplyC
     , m_timeout_aggressive_miliseconds(500)
     , m_nextEventActionId(WebCore::HBAllocateEventActionId())
 {
-    std::ifstream fp;
-    fp.open(schedulePath.c_str());
-    m_schedule = WebCore::EventActionSchedule::deserialize(fp);
-    m_schedule->reverse();
-    fp.close();
+    m_schedule = new WebCore::EventActionScheduleReader(schedulePath);
 
     m_eventActionTimeoutTimer.setInterval(m_timeout_miliseconds); // an event action must be executed within x miliseconds
     m_eventActionTimeoutTimer.setSingleShot(true);
@@ -102,10 +98,10 @@ bool ReplayScheduler::executeDelayedEventAction(WebCore::EventActionRegister* ev
         }
     }
 
-    bool success = tryExecuteEventActionDescriptor(eventActionRegister, m_schedule->last());
+    bool success = tryExecuteEventActionDescriptor(eventActionRegister, m_schedule->next());
 
     if (success) {
-        m_schedule->removeLast();
+        m_schedule->advance();
 
         m_skipAfterNextTry = false;
         m_eventActionTimeoutTimer.stop();
@@ -134,14 +130,14 @@ bool ReplayScheduler::executeDelayedEventAction(WebCore::EventActionRegister* ev
 
         // Notice that we will continue skipping event actions until we get a hit.
 
-        std::stringstream detail;
-        detail << "This is the current queue of events" << std::endl;
-        debugPrintTimers(detail, WebCore::threadGlobalData().threadTimers().eventActionRegister());
+        TimerDump detail;
+        detail.scheduler = this;
+        detail.header = "This is the current queue of events\n";
 
-        WTF::WarningCollectorReport("WEBERA_SCHEDULER", "Event action skipped after timeout.", detail.str());
+        WTF::WarningCollectorReport("WEBERA_SCHEDULER", "Event action skipped after timeout.", &ReplayScheduler::debugPrintTimersDetails, &detail);
 
-        m_schedule_backlog.append(m_schedule->last());
-        m_schedule->removeLast();
+        m_schedule_backlog.append(m_schedule->next());
+        m_schedule->advance();
 
         return true; // Go to the next event action now
 
@@ -149,7 +145,7 @@ bool ReplayScheduler::executeDelayedEventAction(WebCore::EventActionRegister* ev
 
     if (!m_eventActionTimeoutTimer.isActive()) {
 
-        const WebCore::EventActionScheduleItem& item = m_schedule->last();
+        const WebCore::EventActionScheduleItem& item = m_schedule->next();
         const WTF::EventActionDescriptor& nextToSchedule = item.second;
         const std::string& eventActionType = nextToSchedule.getType();
 
@@ -323,11 +319,14 @@ bool ReplayScheduler::tryExecuteEventActionDescriptor(
 
                 std::stringstream details;
                 details << nextToSchedule.toString() << " (expected) fuzzy matched with " << bestDescriptor.toString() << " (score " << bestScore << ")";
-                details << "This is the current queue of events" << std::endl;
-                debugPrintTimers(details, WebCore::threadGlobalData().threadTimers().eventActionRegister());
 
                 std::cout << "Fuzzy match: " << details.str() << std::endl;
-                WTF::WarningCollectorReport("WEBERA_SCHEDULER", "Event action fuzzy matched in best effort mode.", details.str());
+
+                TimerDump detail;
+                detail.scheduler = this;
+                detail.header = details.str() + "This is the current queue of events\n";
+
+                WTF::WarningCollectorReport("WEBERA_SCHEDULER", "Event action fuzzy matched in best effort mode.", &ReplayScheduler::debugPrintTimersDetails, &detail);
 
                 m_timeProvider->setCurrentDescriptorString(QString::fromStdString(bestDescriptor.toUnpatchedString()));
                 m_randomProvider->setCurrentDescriptorString(QString::fromStdString(bestDescriptor.toUnpatchedString()));
@@ -371,12 +370,15 @@ void ReplayScheduler::slEventActionTimeout()
     case BEST_EFFORT_NOND: {
         // This should not happen
 
-        std::stringstream detail;
-        detail << "Error: Failed execution schedule after waiting for " << m_timeout_miliseconds << " miliseconds..." << std::endl;
-        detail << "This is the current queue of events" << std::endl;
-        debugPrintTimers(detail, WebCore::threadGlobalData().threadTimers().eventActionRegister());
+        std::stringstream header;
+        header << "Error: Failed execution schedule after waiting for " << m_timeout_miliseconds << " miliseconds..." << std::endl;
+        header << "This is the current queue of events" << std::endl;
 
-        WTF::WarningCollectorReport("WEBERA_SCHEDULER", "Could not replay schedule while in non-deterministic relax mode", detail.str());
+        TimerDump detail;
+        detail.scheduler = this;
+        detail.header = header.str();
+
+        WTF::WarningCollectorReport("WEBERA_SCHEDULER", "Could not replay schedule while in non-deterministic relax mode", &ReplayScheduler::debugPrintTimersDetails, &detail);
         stop(ERROR);
 
         break;
@@ -415,9 +417,17 @@ void ReplayScheduler::debugPrintTimers(std::ostream& out, WebCore::EventActionRe
 {
     out << "=========== TIMERS ===========" << std::endl;
     out << "RELAXED MODE: " << (m_mode == BEST_EFFORT ? "Yes" : "No") << std::endl;
-    out << "NEXT -> " << m_schedule->last().second.toString() << std::endl;
+    out << "NEXT -> " << m_schedule->next().second.toString() << std::endl;
     out << "QUEUE -> " << std::endl;
 
     eventActionRegister->debugPrintNames(out);
 
 }
+
+void ReplayScheduler::debugPrintTimersDetails(std::ostream& out, void* context)
+{
+    TimerDump* dump = static_cast<TimerDump*>(context);
+
+    out << dump->header;
+    dump->scheduler->debugPrintTimers(out, WebCore::threadGlobalData().threadTimers().eventActionRegister());
+}
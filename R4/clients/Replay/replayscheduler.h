@@ -131,7 +131,15 @@ private:
 
     void debugPrintTimers(std::ostream& out, WebCore::EventActionRegister* eventActionRegister);
 
-    WebCore::EventActionSchedule* m_schedule;
+    // Lazily renders a timer dump as warning details, only invoked if the warning collector keeps the details
+    typedef struct timer_dump_t {
+        ReplayScheduler* scheduler;
+        std::string header;
+    } TimerDump;
+
+    static void debugPrintTimersDetails(std::ostream& out, void* context);
+
+    WebCore::EventActionScheduleReader* m_schedule; // read lazily, one event action ahead
     WTF::Vector<WebCore::EventActionScheduleItem> m_schedule_backlog;
 
     QNetworkReplyControllableFactoryReplay* m_networkProvider;
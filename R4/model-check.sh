@@ -5,7 +5,7 @@ set -ue -o pipefail
 # INPUT HANDLING
 
 if (( ! $# > 0 )); then
-    echo "Usage: <website URL> <base dir> [--verbose] [--auto] [--depth x] [--high-time-limit] [--old-style-bound] [--extras]"
+    echo "Usage: <website URL> <base dir> [--verbose] [--auto] [--depth x] [--high-time-limit] [--old-style-bound] [--network-service] [--js-cache] [--warning-limit N] [--suppress-painting] [--metadata-only-images] [--extras]"
     echo "Outputs result of model-checking the recording in <base dir>/record"
     exit 1
 fi
@@ -25,6 +25,11 @@ TIMEOUT=60
 TIMEOUTCMD=""
 BOUND=""
 EXTRAS=""
+NETWORK_SERVICE=0
+JS_CACHE=0
+WARNINGLIMITCMD=""
+SUPPRESSPAINTINGCMD=""
+METADATAONLYIMAGESCMD=""
 
 while [[ $# > 0 ]]
 do
@@ -48,6 +53,30 @@ case $1 in
         AUTO=1
         shift
     ;;
+    --network-service)
+        NETWORK_SERVICE=1
+        shift
+    ;;
+    --js-cache)
+        JS_CACHE=1
+        shift
+    ;;
+    --suppress-painting)
+        # Skip painting in replays, the screenshots are still rendered
+        SUPPRESSPAINTINGCMD="-suppress-painting"
+        shift
+    ;;
+    --metadata-only-images)
+        # Only decode image headers until a frame is painted or its pixels are read
+        METADATAONLYIMAGESCMD="-metadata-only-images"
+        shift
+    ;;
+    --warning-limit)
+        # Only keep the details of the first N warnings of each kind, report.py can't compare the dropped details
+        shift
+        WARNINGLIMITCMD="-warning-limit $1"
+        shift
+    ;;
     --verbose)
         VERBOSE=1
         shift
@@ -72,6 +101,7 @@ done
 # DO SOMETHING
 
 REPLAY_BIN=$WEBERA_DIR/R4/clients/Replay/bin/replay
+NETWORK_SERVICE_BIN=$WEBERA_DIR/R4/clients/NetworkService/bin/network-service
 ER_BIN=$EVENTRACER_DIR/bin/eventracer/webera/run_schedules
 BER_BIN=$EVENTRACER_DIR/bin/eventracer/webera/webera
 
@@ -94,9 +124,38 @@ echo "Running "  $PROTOCOL $URL " @ " $OUTDIR
 
 mkdir -p $OUTRUNNER
 
+# Share the recorded network log between all replays
+NETWORKCMD=""
+if [[ $NETWORK_SERVICE -eq 1 ]]; then
+    $NETWORK_SERVICE_BIN $OUTRECORD/log.network.data &> $OUTRUNNER/network-service.txt &
+    NETWORK_SERVICE_PID=$!
+    trap "kill $NETWORK_SERVICE_PID 2> /dev/null" EXIT
+
+    # Wait until the log is loaded into shared memory, replays started earlier would read the log themselves
+    for i in $(seq 1 600); do
+        if grep -q "^Serving " $OUTRUNNER/network-service.txt 2> /dev/null; then
+            break
+        fi
+        if ! kill -0 $NETWORK_SERVICE_PID 2> /dev/null; then
+            echo "Error: The network snapshot service failed to start, see $OUTRUNNER/network-service.txt"
+            exit 1
+        fi
+        sleep 0.1
+    done
+
+    NETWORKCMD="-network-service"
+fi
+
+# Share the parsed function info of the site's scripts between all replays
+JSCACHECMD=""
+if [[ $JS_CACHE -eq 1 ]]; then
+    mkdir -p $OUTDIR/js-cache
+    JSCACHECMD="-js-cache $OUTDIR/js-cache"
+fi
+
 CMD="/usr/bin/time -p $ER_BIN $BOUND $EXTRAS -conflict_reversal_bound=$DEPTH -in_dir=$OUTRECORD/ -in_schedule_file=$OUTRECORD/schedule.data -tmp_new_schedule_file=$OUTDIR/new_schedule.data -out_dir=$OUTDIR -tmp_error_log=$OUTDIR/out.errors.log -tmp_network_log=$OUTDIR/out.log.network.data -tmp_time_log=$OUTDIR/out.log.time.data -tmp_random_log=$OUTDIR/out.log.random.data -tmp_status_log=$OUTDIR/out.status.data -tmp_png_file=$OUTDIR/out.screenshot.png -tmp_schedule_file=$OUTDIR/out.schedule.data -tmp_stdout=$OUTDIR/stdout.txt -tmp_er_log_file=$OUTDIR/out.ER_actionlog --site=$PROTOCOL://$URL"
 
-REPLAY_CMD="$REPLAY_BIN $AUTOCMD $VERBOSECMD $COOKIESCMD -out_dir $OUTDIR -timeout $TIMEOUT $TIMEOUTCMD -in_dir %s/ \"%s\" %s"
+REPLAY_CMD="$REPLAY_BIN $AUTOCMD $VERBOSECMD $COOKIESCMD $NETWORKCMD $JSCACHECMD $WARNINGLIMITCMD $SUPPRESSPAINTINGCMD $METADATAONLYIMAGESCMD -out_dir $OUTDIR -timeout $TIMEOUT $TIMEOUTCMD -in_dir %s/ \"%s\" %s"
 
 if [[ $VERBOSE -eq 1 ]]; then
     echo "> $CMD --replay_command=\"$REPLAY_CMD\""
@@ -5,12 +5,16 @@ import os
 import difflib
 import re
 import shutil
+import json
 from jinja2 import Environment, PackageLoader
 import subprocess
 from builtins import FileNotFoundError, NotADirectoryError
 import concurrent.futures
 from bs4 import BeautifulSoup
 
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.realpath(__file__)), '..'))
+from errorslog import read_errors_log, ErrorsLogFormatError
+
 NUM_PROC = 7
 
 
@@ -276,6 +280,65 @@ def get_or_create_event_action_memory(base_dir, memory, event_action_id):
 
     return memory
 
+# A summary of the action log (written by replay -actionlog-summary, or by actionlog-convert -summary) holds the
+# same per event action memory digest as the race analyzer code pages, without starting the race analyzer.
+summary_cache = {}
+
+def gen_actionlog_summary(base):
+    convert_bin = os.path.join(os.environ.get('WEBERA_DIR', ''), 'R4/clients/ActionLogConvert/bin/actionlog-convert')
+    actionlog = os.path.join(base, 'ER_actionlog')
+
+    if not os.path.exists(convert_bin) or not os.path.exists(actionlog):
+        return False
+
+    return subprocess.call([convert_bin, '-summary', actionlog, os.path.join(base, 'ER_summary')]) == 0
+
+def load_actionlog_summary(base_dir):
+    global summary_cache
+
+    if base_dir not in summary_cache:
+        summary_cache[base_dir] = None
+
+        path = os.path.join(base_dir, 'ER_summary.json')
+
+        if os.path.exists(path) or gen_actionlog_summary(base_dir):
+            with open(path, 'r', errors='replace') as fp:
+                summary_cache[base_dir] = json.load(fp)
+
+            print('Reading the abstract memory of', base_dir, 'from', path)
+        else:
+            print('Reading the abstract memory of', base_dir, 'from the race analyzer')
+
+    return summary_cache[base_dir]
+
+def get_summary_event_action_memory(summary, memory, event_action_id):
+
+    digest = summary['event_actions'].get(str(event_action_id), None)
+
+    if digest is None:
+        print('Warning, event action', event_action_id, 'is missing from the action log summary')
+        return memory
+
+    known_ids = []
+
+    for location, value in digest['written'].items():
+        if 'CachedResource' in location:
+            # Cached resources never have a value
+            memory[location] = "?"
+
+        elif 'Timer:' in location:
+            known_ids.append(location.split(':')[1])
+            memory['TIMER'] = memory.get('TIMER', 0) + 1
+
+        elif value is not None:
+            memory[location] = '??' if value in known_ids else value
+
+    for triggered in digest['triggered']:
+        location = 'event action %s' % triggered
+        memory[location] = memory.get(location, 0) + 1
+
+    return memory
+
 def get_abstract_memory(base_dir, namespace, event_handler1, event_handler2):
 
     if not event_handler1 or not event_handler2:
@@ -284,6 +347,13 @@ def get_abstract_memory(base_dir, namespace, event_handler1, event_handler2):
     race_first_id, race_first_descriptor = event_handler1
     race_second_id, race_second_descriptor = event_handler2
 
+    summary = load_actionlog_summary(base_dir)
+
+    if summary is not None:
+        memory = get_summary_event_action_memory(summary, {}, race_first_id)
+        memory = get_summary_event_action_memory(summary, memory, race_second_id)
+        return memory
+
     create_if_missing_event_action_code(base_dir, namespace, race_first_id, race_second_id)
 
     memory = get_or_create_event_action_memory(base_dir, {}, race_first_id)
@@ -350,19 +420,13 @@ def parse_race(base_dir, handle):
         raise RaceParseException()
 
     with fp:
-        while True:
-            header = fp.readline().decode('utf8', 'ignore')
-
-            if header == '':
-                break  # EOF reached
-
-            event_action_id, module, description, length = header.split(';')
-            length = int(length)
+        try:
+            warnings = list(read_errors_log(fp))
+        except ErrorsLogFormatError as e:
+            print('Warning, %s (%s)' % (e, errors_file))
+            raise RaceParseException()
 
-            if length == 0:
-                details = ''
-            else:
-                details = fp.read(length).decode('utf8', 'ignore')
+        for event_action_id, module, description, details in warnings:
 
             container = errors
             t = 'error'
@@ -1068,7 +1132,7 @@ def process(job):
         print('Error, missing base or record directory in output dir for %s' % website)
         return None
 
-    ignore_files = ['runner', 'record.png', 'arcs.log', 'out.schedule.data', 'new_schedule.data', 'stdout.txt', 'out.ER_actionlog', 'out.log.network.data', 'out.log.time.data', 'out.log.random.data', 'out.status.data']
+    ignore_files = ['runner', 'record.png', 'arcs.log', 'out.schedule.data', 'new_schedule.data', 'stdout.txt', 'out.ER_actionlog', 'out.ER_summary', 'out.ER_summary.json', 'out.eventactionids.data', 'out.log.network.data', 'out.log.time.data', 'out.log.random.data', 'out.status.data']
 
     races = [race for race in races if not race.startswith('_') and not race in ignore_files]
 
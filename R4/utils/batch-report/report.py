@@ -5,12 +5,18 @@ import os
 import difflib
 import re
 import shutil
+import json
+import struct
+import tempfile
 from jinja2 import Environment, PackageLoader
 import subprocess
 from builtins import FileNotFoundError, NotADirectoryError
 from bs4 import BeautifulSoup
 import simplejson
 
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.realpath(__file__)), '..'))
+from errorslog import read_errors_log, ErrorsLogFormatError
+
 def gen_varlist_memlist(base, port):
     try:
         cmd = '$WEBERA_DIR/R4/er-classify.sh %s %s' % (base, port)
@@ -144,8 +150,20 @@ def get_memory_stats(race_dir, key, namespace):
 
 RE_value_with_memory = re.compile('\[.*\]|event action [0-9]+|IO_[0-9]+|:0x[abcdef\-0-9]+|:[0-9]+|0x[abcdef0-9]+|x_x[0-9]+')
 
+# Strings longer than 64 characters are logged as a prefix and a fingerprint of the whole string,
+# '"prefix"...[length:hash]' (see ActionLogReportStringValue). The fingerprint is kept as it is by anon().
+RE_string_fingerprint = re.compile('\\.\\.\\.\\[[0-9]+:[0-9a-f]{16}\\]$')
+
 def anon(value, known_ids=[]):
-    return RE_value_with_memory.sub('[??]', str(value)) if value not in known_ids else 'ID'
+    if value in known_ids:
+        return 'ID'
+
+    value = str(value)
+    fingerprint = RE_string_fingerprint.search(value)
+    if fingerprint:
+        return RE_value_with_memory.sub('[??]', value[:fingerprint.start()]) + fingerprint.group(0)
+
+    return RE_value_with_memory.sub('[??]', value)
 
 def abstract_memory_equal(handle, m1, m2):
 
@@ -200,6 +218,36 @@ def abstract_memory_equal(handle, m1, m2):
             [k for k,v in m1.items() if '%s=%s' % (anon(k), anon(v, known_ids)) not in memory2],
             [k for k,v in m2.items() if k not in ignore_memory2_keys and '%s=%s' % (anon(k), anon(v, known_ids)) not in memory1])
 
+def check_abstract_memory():
+    """
+    Checks abstract_memory_equal on logged values, returns False if a check fails
+    """
+
+    def equal(m1, m2):
+        return abstract_memory_equal('check', m1, m2)[0]
+
+    prefix = '"%s"' % ('x' * 16)
+    checks = [
+        ('pointers are ignored',
+         equal({'Array[0x1234]:value': '0x5678'}, {'Array[0x9abc]:value': '0xdef0'})),
+        ('equal long strings compare equal',
+         equal({'Array[0x1]:value': prefix + '...[300:0123456789abcdef]'},
+               {'Array[0x2]:value': prefix + '...[300:0123456789abcdef]'})),
+        ('long strings differing after the prefix compare unequal',
+         not equal({'Array[0x1]:value': prefix + '...[300:0123456789abcdef]'},
+                   {'Array[0x1]:value': prefix + '...[300:fedcba9876543210]'})),
+        ('long strings differing in length compare unequal',
+         not equal({'Array[0x1]:value': prefix + '...[300:0123456789abcdef]'},
+                   {'Array[0x1]:value': prefix + '...[301:0123456789abcdef]'})),
+    ]
+
+    ok = True
+    for name, passed in checks:
+        print('%s: %s' % ('OK' if passed else 'FAILED', name))
+        ok = ok and passed
+
+    return ok
+
 def create_if_missing_event_action_code(base_dir, namespace, *args):
 
     to_be_added = []
@@ -277,11 +325,81 @@ def get_or_create_event_action_memory(base_dir, memory, namespace, event_action_
 
     return memory
 
+# A summary of the action log (written by replay -actionlog-summary, or by actionlog-convert -summary) holds the
+# same per event action memory digest as the race analyzer code pages, without starting the race analyzer.
+summary_cache = {}
+
+def gen_actionlog_summary(base):
+    convert_bin = os.path.join(os.environ.get('WEBERA_DIR', ''), 'R4/clients/ActionLogConvert/bin/actionlog-convert')
+    actionlog = os.path.join(base, 'ER_actionlog')
+
+    if not os.path.exists(convert_bin) or not os.path.exists(actionlog):
+        return False
+
+    return subprocess.call([convert_bin, '-summary', actionlog, os.path.join(base, 'ER_summary')]) == 0
+
+def load_actionlog_summary(base_dir):
+    global summary_cache
+
+    if base_dir not in summary_cache:
+        summary_cache[base_dir] = None
+
+        path = os.path.join(base_dir, 'ER_summary.json')
+
+        if os.path.exists(path) or gen_actionlog_summary(base_dir):
+            with open(path, 'r', errors='replace') as fp:
+                summary_cache[base_dir] = json.load(fp)
+
+            print('Reading the abstract memory of', base_dir, 'from', path)
+        else:
+            print('Reading the abstract memory of', base_dir, 'from the race analyzer')
+
+    return summary_cache[base_dir]
+
+def get_summary_event_action_memory(summary, memory, event_action_id):
+    """
+    Same as get_or_create_event_action_memory, but read from the action log summary. The value of a location is the first
+    value the event action wrote to it, as the action log records a single write per location and event action.
+    """
+
+    digest = summary['event_actions'].get(str(event_action_id), None)
+
+    if digest is None:
+        print('Warning, event action', event_action_id, 'is missing from the action log summary')
+        return memory
+
+    known_ids = []
+
+    for location, value in digest['written'].items():
+        if 'CachedResource' in location:
+            # Cached resources never have a value
+            memory[location] = "?"
+
+        elif 'Timer:' in location:
+            known_ids.append(location.split(':')[1])
+            memory['TIMER'] = memory.get('TIMER', 0) + 1
+
+        elif value is not None:
+            memory[location] = '??' if value in known_ids else value
+
+    for triggered in digest['triggered']:
+        location = 'event action %s' % triggered
+        memory[location] = memory.get(location, 0) + 1
+
+    return memory
+
 def get_abstract_memory(base_dir, namespace, event_handler1, event_handler2):
 
     race_first_id, race_first_descriptor = event_handler1
     race_second_id, race_second_descriptor = event_handler2
 
+    summary = load_actionlog_summary(base_dir)
+
+    if summary is not None:
+        memory = get_summary_event_action_memory(summary, {}, race_first_id)
+        memory = get_summary_event_action_memory(summary, memory, race_second_id)
+        return memory
+
     create_if_missing_event_action_code(base_dir, namespace, race_first_id, race_second_id)
 
     memory = get_or_create_event_action_memory(base_dir, {}, namespace, race_first_id)
@@ -289,6 +407,77 @@ def get_abstract_memory(base_dir, namespace, event_handler1, event_handler2):
 
     return memory
 
+def write_raw_actionlog(path, variables, values, event_actions):
+    """
+    Writes an ER_actionlog in the raw format, event_actions maps ids to lists of (command type, location) where
+    locations are indices in variables (reads and writes) or values (MEMORY_VALUE)
+    """
+
+    def string_set(strings):
+        data = b''.join(s.encode('utf-8') + b'\0' for s in strings)
+        return struct.pack('=i', len(data)) + data + struct.pack('=i', 2 * len(strings) + 3)
+
+    def offsets(strings):
+        result = []
+        offset = 0
+        for s in strings:
+            result.append(offset)
+            offset += len(s.encode('utf-8')) + 1
+        return result
+
+    variable_offsets = offsets(variables)
+    value_offsets = offsets(values)
+
+    MEMORY_VALUE = 5
+
+    with open(path, 'wb') as fp:
+        fp.write(string_set(variables))
+        fp.write(string_set([]))
+        fp.write(struct.pack('=ii', len(event_actions), 0))
+        for event_action_id, commands in sorted(event_actions.items()):
+            fp.write(struct.pack('=iii', event_action_id, 0, len(commands)))
+            for command, location in commands:
+                offset = value_offsets[location] if command == MEMORY_VALUE else variable_offsets[location]
+                fp.write(struct.pack('=ii', command, offset))
+        fp.write(string_set([]))
+        fp.write(string_set(values))
+
+def check_actionlog_summary():
+    """
+    Checks the action log summary written by actionlog-convert, returns False if a check fails
+    """
+
+    READ_MEMORY, WRITE_MEMORY, MEMORY_VALUE = 2, 3, 5
+
+    base = tempfile.mkdtemp()
+
+    try:
+        write_raw_actionlog(os.path.join(base, 'ER_actionlog'), ['x', 'y'], ['"first"', '"second"'], {
+            1: [(WRITE_MEMORY, 0), (MEMORY_VALUE, 0), (READ_MEMORY, 1), (MEMORY_VALUE, 1), (WRITE_MEMORY, 0), (MEMORY_VALUE, 1)]
+        })
+
+        if not gen_actionlog_summary(base):
+            print('SKIPPED: the action log summary (actionlog-convert is missing, set WEBERA_DIR)')
+            return True
+
+        with open(os.path.join(base, 'ER_summary.json'), 'r') as fp:
+            digest = json.load(fp)['event_actions']['1']
+
+    finally:
+        shutil.rmtree(base)
+
+    checks = [
+        ('the summary keeps the first value written', digest['written'] == {'x': '"first"'}),
+        ('the summary counts every write', digest['writes'] == 2),
+    ]
+
+    ok = True
+    for name, passed in checks:
+        print('%s: %s' % ('OK' if passed else 'FAILED', name))
+        ok = ok and passed
+
+    return ok
+
 
 class RaceParseException(Exception):
     pass
@@ -348,19 +537,13 @@ def parse_race(base_dir, handle):
         raise RaceParseException()
 
     with fp:
-        while True:
-            header = fp.readline().decode('utf8', 'ignore')
-
-            if header == '':
-                break  # EOF reached
-
-            event_action_id, module, description, length = header.split(';')
-            length = int(length)
+        try:
+            warnings = list(read_errors_log(fp))
+        except ErrorsLogFormatError as e:
+            print('Warning, %s (%s)' % (e, errors_file))
+            raise RaceParseException()
 
-            if length == 0:
-                details = ''
-            else:
-                details = fp.read(length).decode('utf8', 'ignore')
+        for event_action_id, module, description, details in warnings:
 
             container = errors
             t = 'error'
@@ -422,6 +605,21 @@ def parse_race(base_dir, handle):
     if state_match is None:
         print('Warning, state not found in file:', stdout_file)
 
+    # STATUS
+
+    screenshot_hash = None
+
+    status_file = os.path.join(handle_dir, 'out.status.data')
+    if not os.path.exists(status_file):
+        status_file = os.path.join(handle_dir, 'status.data')
+
+    if os.path.exists(status_file):
+        with open(status_file, 'rb') as fp:
+            screenshot_match = re.compile('Screenshot-hash: ([0-9]+)').search(fp.read().decode('utf8', 'ignore'))
+
+            if screenshot_match is not None:
+                screenshot_hash = screenshot_match.group(1)
+
     # Origin
 
     origin = None
@@ -584,6 +782,7 @@ def parse_race(base_dir, handle):
         'zip_errors_schedule': zip_errors_schedule,
         'result': result_match.group(1) if result_match is not None else 'ERROR',
         'html_state': state_match.group(1) if state_match is not None else 'ERROR',
+        'screenshot_hash': screenshot_hash,
         'race_dir': handle_dir,
         'origin': origin,
         'raceFirst': raceFirst,
@@ -692,7 +891,19 @@ def compare_race(base_data, race_data, namespace):
 
     cimage_meta = os.path.join(race_data['race_dir'], 'comparison.txt')
 
-    if not os.path.isfile(cimage_meta):
+    if not os.path.isfile(cimage_meta) and base_data['screenshot_hash'] is not None and \
+            base_data['screenshot_hash'] == race_data['screenshot_hash']:
+
+        # Identical pixels (Screenshot-hash is exact, unlike Screenshot-dhash), skip the image diff
+        # (the replay may not have written the PNG)
+
+        cimage = {
+            'distance': 0.0,
+            'match_type': 'normal',
+            'human': cimage_human('normal', 0)
+        }
+
+    elif not os.path.isfile(cimage_meta):
 
         file1 = os.path.join(base_data['race_dir'], 'out.screenshot.png')
         if not os.path.exists(file1):
@@ -1172,7 +1383,7 @@ def process(job):
         print('Error, missing base or record directory in output dir for %s' % website)
         return None
 
-    ignore_files = ['runner', 'record.png', 'arcs.log', 'out.schedule.data', 'new_schedule.data', 'stdout.txt', 'out.ER_actionlog', 'out.log.network.data', 'out.log.time.data', 'out.log.random.data', 'out.status.data']
+    ignore_files = ['runner', 'record.png', 'arcs.log', 'out.schedule.data', 'new_schedule.data', 'stdout.txt', 'out.ER_actionlog', 'out.ER_summary', 'out.ER_summary.json', 'out.eventactionids.data', 'out.log.network.data', 'out.log.time.data', 'out.log.random.data', 'out.status.data']
 
     races = [race for race in races if not race.startswith('_') and not race in ignore_files]
 
@@ -1350,7 +1561,11 @@ def main():
     try:
         command = sys.argv[1]
         
-        if command == 'website':
+        if command == 'check':
+            ok = check_abstract_memory()
+            ok = check_actionlog_summary() and ok
+            sys.exit(0 if ok else 1)
+        elif command == 'website':
             arg1 = sys.argv[2]
             arg2 = sys.argv[3]
             arg3 = sys.argv[4]
@@ -1367,7 +1582,8 @@ def main():
         print("""Usage: %s command
 website <analysis-dir> <report-dir> <website>
 index <analysis-dir> <report-dir>
-query <website-dir> <race>""" % sys.argv[0])
+query <website-dir> <race>
+check""" % sys.argv[0])
         sys.exit(1)
 
     if command == 'website':
@@ -0,0 +1,378 @@
+#!/usr/bin/env python3
+
+"""
+Record/replay throughput benchmark.
+
+Serves the pages in R4/examples, together with a set of generated stress pages, from a loopback HTTP server
+(or as file:// URLs) and runs record and replay N times on each page with a hidden window.
+
+For each run the wall time, CPU time, event actions per second, logged commands per second, peak RSS and the
+size of the produced files are measured, as well as the startup time of the clients. The results are written
+as JSON.
+
+Run once with and once without --headless to compare the headless clients against the windowed clients.
+
+Event actions are counted in schedule.data, commands are read from the profiling trace (-profile-trace json).
+"""
+
+import argparse
+import http.server
+import json
+import os
+import shutil
+import socketserver
+import statistics
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+DEFAULT_PAGES = ['simple-race.html', 'ajax.html', 'timer.html', 'harm1.html', 'user.html', 'pex.html']
+
+
+def abs_path(rel_path):
+    return os.path.join(
+        os.path.dirname(os.path.dirname(os.path.realpath(__file__))),
+        rel_path
+    )
+
+
+# Stress pages
+
+def stress_deep_dom(scale):
+    depth = 200 * scale
+    body = '<div>' * depth + 'deep' + '</div>' * depth
+    script = '''
+        var node = document.body;
+        var depth = 0;
+        while (node.firstChild) { node = node.firstChild; depth++; }
+        node.parentNode.setAttribute("data-depth", depth);
+    '''
+    return page('Deep DOM', '', body + '<script>%s</script>' % script)
+
+
+def stress_many_timers(scale):
+    timers = 1000 * scale
+    script = '''
+        var fired = 0;
+        for (var i = 0; i < %d; i++) {
+            setTimeout(function() { fired++; }, i %% 50);
+        }
+        var ticks = 0;
+        var interval = setInterval(function() { if (++ticks == 20) clearInterval(interval); }, 10);
+    ''' % timers
+    return page('Many timers', '<script>%s</script>' % script, '')
+
+
+def stress_large_script(scale):
+    functions = 2000 * scale
+    parts = ['var sum = 0;']
+    for i in range(functions):
+        parts.append('function f%d(x) { var y = x * %d; sum += y; return y; }' % (i, i))
+    parts.append('for (var i = 0; i < %d; i++) { window["f" + i](i); }' % functions)
+    return page('Large script', '<script>%s</script>' % '\n'.join(parts), '')
+
+
+def stress_many_xhrs(scale):
+    requests = 100 * scale
+    script = '''
+        var done = 0;
+        for (var i = 0; i < %d; i++) {
+            (function(i) {
+                var xhr = new XMLHttpRequest();
+                xhr.onreadystatechange = function() {
+                    if (xhr.readyState == 4) { done++; }
+                };
+                xhr.open("GET", "resource.json?" + i, true);
+                xhr.send();
+            })(i);
+        }
+    ''' % requests
+    return page('Many XHRs', '<script>%s</script>' % script, '')
+
+
+def page(title, head, body):
+    return '<!doctype html>\n<html>\n<head>\n<meta charset="utf-8">\n<title>%s</title>\n%s\n</head>\n<body>\n%s\n</body>\n</html>\n' % (title, head, body)
+
+
+STRESS_PAGES = {
+    'stress-deep-dom.html': stress_deep_dom,
+    'stress-many-timers.html': stress_many_timers,
+    'stress-large-script.html': stress_large_script,
+    'stress-many-xhrs.html': stress_many_xhrs,
+}
+
+
+def prepare_site(site_dir, scale):
+    shutil.copytree(abs_path('examples'), site_dir)
+
+    for name, generator in STRESS_PAGES.items():
+        with open(os.path.join(site_dir, name), 'w') as fp:
+            fp.write(generator(scale))
+
+
+class QuietHandler(http.server.SimpleHTTPRequestHandler):
+
+    def log_message(self, format, *args):
+        pass
+
+
+def start_server(site_dir):
+    class Handler(QuietHandler):
+        def __init__(self, *args, **kwargs):
+            super().__init__(*args, directory=site_dir, **kwargs)
+
+    socketserver.ThreadingTCPServer.allow_reuse_address = True
+    server = socketserver.ThreadingTCPServer(('127.0.0.1', 0), Handler)
+    server.daemon_threads = True
+
+    thread = threading.Thread(target=server.serve_forever)
+    thread.daemon = True
+    thread.start()
+
+    return server
+
+
+# Measurements
+
+def run_measured(cmd, log_path, timeout):
+    """
+    Runs cmd and returns (exit code, wall time in seconds, CPU time in seconds, peak RSS in KB).
+    """
+
+    with open(log_path, 'wb') as log:
+        start = time.monotonic()
+        process = subprocess.Popen(cmd, stdout=log, stderr=subprocess.STDOUT)
+
+        timer = threading.Timer(timeout, process.kill)
+        timer.start()
+        try:
+            _, status, rusage = os.wait4(process.pid, 0)
+        finally:
+            timer.cancel()
+
+        wall = time.monotonic() - start
+        process.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -os.WTERMSIG(status)
+
+    return process.returncode, wall, rusage.ru_utime + rusage.ru_stime, rusage.ru_maxrss
+
+
+def count_event_actions(out_dir, prefix):
+    path = os.path.join(out_dir, prefix + 'schedule.data')
+    if not os.path.isfile(path):
+        return 0
+
+    with open(path, 'r', errors='replace') as fp:
+        return sum(1 for line in fp if line.strip() and line.strip() not in ('<relax>', '<change>'))
+
+
+def count_commands(out_dir, prefix):
+    path = os.path.join(out_dir, prefix + 'profile.trace.json')
+    if not os.path.isfile(path):
+        return None, 0
+
+    with open(path, 'r') as fp:
+        trace = json.load(fp)
+
+    commands = sum(event.get('args', {}).get('commands', 0) for event in trace.get('traceEvents', []))
+    return commands, trace.get('otherData', {}).get('dropped', 0)
+
+
+def output_sizes(out_dir):
+    sizes = {}
+    for name in sorted(os.listdir(out_dir)):
+        path = os.path.join(out_dir, name)
+        if os.path.isfile(path) and name != 'out.log':
+            sizes[name] = os.path.getsize(path)
+    return sizes
+
+
+def measure(mode, cmd, out_dir, prefix, timeout):
+    os.makedirs(out_dir, exist_ok=True)
+
+    returncode, wall, cpu, peak_rss = run_measured(cmd, os.path.join(out_dir, 'out.log'), timeout)
+
+    event_actions = count_event_actions(out_dir, prefix)
+    commands, dropped = count_commands(out_dir, prefix)
+
+    result = {
+        'mode': mode,
+        'exit_code': returncode,
+        'wall_time_s': wall,
+        'cpu_time_s': cpu,
+        'event_actions': event_actions,
+        'event_actions_per_s': event_actions / wall if wall > 0 else 0,
+        'commands': commands,
+        'commands_per_s': commands / wall if commands is not None and wall > 0 else None,
+        'profile_records_dropped': dropped,
+        'peak_rss_kb': peak_rss,
+        'output_bytes': output_sizes(out_dir),
+    }
+    result['output_bytes_total'] = sum(result['output_bytes'].values())
+
+    return result
+
+
+def summarize(runs):
+    summary = {}
+    for key in ('wall_time_s', 'cpu_time_s', 'event_actions_per_s', 'commands_per_s', 'peak_rss_kb', 'output_bytes_total'):
+        values = [run[key] for run in runs if run.get(key) is not None and run['exit_code'] == 0]
+        if values:
+            summary[key] = {
+                'median': statistics.median(values),
+                'min': min(values),
+                'max': max(values),
+            }
+    summary['failures'] = sum(1 for run in runs if run['exit_code'] != 0)
+    return summary
+
+
+def window_option(args):
+    return '-headless' if args.headless else '-hidewindow'
+
+
+def benchmark_startup(args, work_dir):
+    """
+    Startup time of the clients: the time to set up the application and the window and to print the usage.
+    """
+
+    wrapper = ['xvfb-run', '-a'] if args.xvfb else []
+    results = {}
+
+    for mode in ('record', 'replay'):
+        client_bin = abs_path('clients/%s/bin/%s' % (mode.capitalize(), mode))
+        runs = []
+
+        for i in range(args.iterations):
+            out_dir = os.path.join(work_dir, 'startup', mode, str(i))
+            os.makedirs(out_dir)
+
+            cmd = wrapper + [client_bin, window_option(args), '-help']
+            returncode, wall, cpu, peak_rss = run_measured(cmd, os.path.join(out_dir, 'out.log'), args.timeout)
+            runs.append({'exit_code': returncode, 'wall_time_s': wall, 'cpu_time_s': cpu, 'peak_rss_kb': peak_rss})
+
+        results[mode] = {'runs': runs, 'summary': summarize(runs)}
+
+    return results
+
+
+def benchmark_page(name, url, args, work_dir):
+    record_bin = abs_path('clients/Record/bin/record')
+    replay_bin = abs_path('clients/Replay/bin/replay')
+
+    wrapper = ['xvfb-run', '-a'] if args.xvfb else []
+
+    record_runs = []
+    replay_runs = []
+
+    for i in range(args.iterations):
+        record_dir = os.path.join(work_dir, name, str(i), 'record')
+        replay_dir = os.path.join(work_dir, name, str(i), 'replay')
+
+        record_cmd = wrapper + [record_bin,
+                                window_option(args),
+                                '-autoexplore',
+                                '-pre-autoexplore-timeout', str(args.pre_autoexplore_timeout),
+                                '-autoexplore-timeout', str(args.autoexplore_timeout),
+                                '-profile-trace', 'json',
+                                '-out_dir', record_dir,
+                                url]
+
+        if args.verbose:
+            print('  record %d: %s' % (i, ' '.join(record_cmd)))
+
+        record_runs.append(measure('record', record_cmd, record_dir, '', args.timeout))
+
+        replay_cmd = wrapper + [replay_bin,
+                                window_option(args),
+                                '-profile-trace', 'json',
+                                '-in_dir', record_dir + '/',
+                                '-out_dir', replay_dir,
+                                url,
+                                os.path.join(record_dir, 'schedule.data')]
+
+        if args.verbose:
+            print('  replay %d: %s' % (i, ' '.join(replay_cmd)))
+
+        replay_runs.append(measure('replay', replay_cmd, replay_dir, 'out.', args.timeout))
+
+    return {
+        'page': name,
+        'url': url,
+        'record': {'runs': record_runs, 'summary': summarize(record_runs)},
+        'replay': {'runs': replay_runs, 'summary': summarize(replay_runs)},
+    }
+
+
+if __name__ == '__main__':
+
+    parser = argparse.ArgumentParser(description='Record/replay throughput benchmark on R4/examples and synthetic stress pages.')
+    parser.add_argument('pages', nargs='*', help='pages to benchmark (default: the examples and all stress pages)')
+    parser.add_argument('-n', '--iterations', type=int, default=3, help='runs of record and replay per page')
+    parser.add_argument('--scale', type=int, default=1, help='size multiplier for the stress pages')
+    parser.add_argument('--file', action='store_true', help='load pages as file:// URLs instead of from a loopback server')
+    parser.add_argument('--xvfb', action='store_true', help='run the clients under xvfb-run')
+    parser.add_argument('--headless', action='store_true', help='run the clients with -headless instead of -hidewindow')
+    parser.add_argument('--timeout', type=int, default=300, help='seconds before a run is killed')
+    parser.add_argument('--autoexplore-timeout', type=int, default=5)
+    parser.add_argument('--pre-autoexplore-timeout', type=int, default=1)
+    parser.add_argument('--out', default='benchmark.json', help='result file (- for stdout)')
+    parser.add_argument('--keep', action='store_true', help='keep the recorded and replayed files')
+    parser.add_argument('--verbose', action='store_true')
+    args = parser.parse_args()
+
+    pages = args.pages or DEFAULT_PAGES + sorted(STRESS_PAGES.keys())
+
+    work_dir = tempfile.mkdtemp(prefix='webera-benchmark-')
+    site_dir = os.path.join(work_dir, 'site')
+    prepare_site(site_dir, args.scale)
+
+    server = None
+    if args.file:
+        base_url = 'file://%s/' % site_dir
+    else:
+        server = start_server(site_dir)
+        base_url = 'http://127.0.0.1:%d/' % server.server_address[1]
+
+    results = []
+    startup = None
+
+    try:
+        print('Benchmarking startup')
+        startup = benchmark_startup(args, os.path.join(work_dir, 'runs'))
+
+        for name in pages:
+            if not os.path.isfile(os.path.join(site_dir, name)):
+                print('Unknown page %s' % name, file=sys.stderr)
+                sys.exit(1)
+
+            print('Benchmarking %s' % name)
+            results.append(benchmark_page(name, base_url + name, args, os.path.join(work_dir, 'runs')))
+
+    finally:
+        if server is not None:
+            server.shutdown()
+
+    report = {
+        'timestamp': time.strftime('%Y-%m-%dT%H:%M:%S'),
+        'iterations': args.iterations,
+        'scale': args.scale,
+        'transport': 'file' if args.file else 'http',
+        'window': 'headless' if args.headless else 'hidden',
+        'startup': startup,
+        'pages': results,
+    }
+
+    if args.out == '-':
+        json.dump(report, sys.stdout, indent=2)
+        print('')
+    else:
+        with open(args.out, 'w') as fp:
+            json.dump(report, fp, indent=2)
+        print('Result written to %s' % args.out)
+
+    if args.keep:
+        print('Runs kept in %s' % work_dir)
+    else:
+        shutil.rmtree(work_dir, ignore_errors=True)
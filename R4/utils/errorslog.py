@@ -0,0 +1,75 @@
+"""
+Reader for the errors.log files written by WTF::WarningCollector, shared by the report and minimization scripts.
+"""
+
+import struct
+
+NO_DETAILS = 0xFFFFFFFF
+
+
+class ErrorsLogFormatError(Exception):
+    pass
+
+
+def read_errors_log(fp):
+    """
+    Yields (event_action_id, module, description, details) from an errors.log file opened in binary mode, in
+    either the text or the binary (ERWL) format
+    """
+
+    magic = fp.read(4)
+
+    if magic != b'ERWL':
+        fp.seek(0)
+
+        while True:
+            header = fp.readline().decode('utf8', 'ignore')
+
+            if header == '':
+                break  # EOF reached
+
+            event_action_id, module, description, length = header.split(';')
+            length = int(length)
+
+            if length == 0:
+                details = ''
+            else:
+                details = fp.read(length).decode('utf8', 'ignore')
+
+            yield event_action_id, module, description, details
+
+        return
+
+    def read_uint32():
+        data = fp.read(4)
+        if len(data) != 4:
+            raise ErrorsLogFormatError('truncated errors.log')
+        return struct.unpack('<I', data)[0]
+
+    read_uint32()  # version
+
+    strings = []
+    for _ in range(read_uint32()):
+        strings.append(fp.read(read_uint32()).decode('utf8', 'ignore'))
+
+    def string(string_id):
+        if string_id >= len(strings):
+            raise ErrorsLogFormatError('string id %d out of range in errors.log' % string_id)
+        return strings[string_id]
+
+    categories = []
+    for _ in range(read_uint32()):
+        module, description, _count = read_uint32(), read_uint32(), read_uint32()
+        categories.append((string(module), string(description)))
+
+    for _ in range(read_uint32()):
+        event_action_id, category, details = read_uint32(), read_uint32(), read_uint32()
+        event_action_id = struct.unpack('<i', struct.pack('<I', event_action_id))[0]
+
+        if category >= len(categories):
+            raise ErrorsLogFormatError('category id %d out of range in errors.log' % category)
+
+        module, description = categories[category]
+        details = '' if details == NO_DETAILS else string(details) + '\n'  # match the text format
+
+        yield str(event_action_id), module, description, details
@@ -0,0 +1,482 @@
+#!/usr/bin/env python3
+
+"""
+Schedule minimizer.
+
+Shrinks a schedule reproducing a race (e.g. new_schedule.data of a race) to the event actions needed to reach
+the racing pair.
+
+The happens-before arcs of the schedule's ER_actionlog give the event actions ordered before the racing pair,
+these are always kept. Of the remaining event actions, delta debugging finds a small set to keep as well:
+a candidate schedule is accepted only if replaying it gives the same result, HTML-hash and warnings as
+replaying the input schedule.
+
+The racing pair is read from the <change> and <relax> markers in the schedule (the event action following
+<change> is the first racing event action, the one following <relax> the second), or given with --race.
+Markers are kept in place. Only input schedules have markers, the replay consumes them: minimize the
+out.schedule.data of a replay with --race.
+
+The arcs must number the event actions like the schedule. A replay numbers the event actions anew, its
+out.ER_actionlog is mapped to the ids of its input schedule with the out.eventactionids.data it writes. The
+ER_actionlog of a recording and the out.ER_actionlog of a replay number the event actions like their
+schedule.data and out.schedule.data.
+"""
+
+import argparse
+import collections
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from errorslog import read_errors_log, ErrorsLogFormatError
+
+LOG_FILES = ['log.network.data', 'log.time.data', 'log.random.data', 'log.storage.data', 'status.data']
+
+
+def abs_path(rel_path):
+    return os.path.join(
+        os.path.dirname(os.path.dirname(os.path.realpath(__file__))),
+        rel_path
+    )
+
+
+# Schedules
+
+class Schedule(object):
+
+    def __init__(self, lines):
+        self.lines = lines
+
+    @staticmethod
+    def load(path):
+        with open(path, 'r', errors='replace') as fp:
+            return Schedule([line.rstrip('\n') for line in fp if line.strip() != ''])
+
+    @staticmethod
+    def is_marker(line):
+        return line in ('<relax>', '<change>')
+
+    @staticmethod
+    def event_action_id(line):
+        return int(line.split(';', 1)[0])
+
+    @staticmethod
+    def event_action_type(line):
+        descriptor = line.split(';', 1)[1]
+        return descriptor[descriptor.find('-') + 1:descriptor.find('(')]
+
+    def event_action_ids(self):
+        return [Schedule.event_action_id(line) for line in self.lines if not Schedule.is_marker(line)]
+
+    def race(self):
+        first = None
+        second = None
+        expect = None
+
+        for line in self.lines:
+            if Schedule.is_marker(line):
+                expect = line
+            elif expect is not None:
+                if expect == '<change>' and first is None:
+                    first = Schedule.event_action_id(line)
+                elif expect == '<relax>' and second is None:
+                    second = Schedule.event_action_id(line)
+                expect = None
+
+        return first, second
+
+    def restrict(self, keep):
+        return Schedule([line for line in self.lines
+                         if Schedule.is_marker(line) or Schedule.event_action_id(line) in keep])
+
+    def save(self, path):
+        with open(path, 'w') as fp:
+            for line in self.lines:
+                fp.write(line + '\n')
+
+
+# Happens before
+
+def read_arcs(actionlog, arcs_file):
+    if arcs_file is not None:
+        with open(arcs_file, 'r') as fp:
+            output = fp.read()
+    else:
+        convert_bin = abs_path('clients/ActionLogConvert/bin/actionlog-convert')
+        output = subprocess.check_output([convert_bin, '-arcs', actionlog]).decode('utf8', 'ignore')
+
+    predecessors = collections.defaultdict(set)
+    for line in output.splitlines():
+        if '->' not in line:
+            continue
+        tail, head = line.split('->')
+        predecessors[int(head.strip())].add(int(tail.strip()))
+
+    return predecessors
+
+
+def read_event_action_ids(path):
+    """
+    Reads the eventactionids.data of a replay, returns a map from the ids of the replay to the ids of its input
+    schedule
+    """
+
+    ids = {}
+
+    with open(path, 'r') as fp:
+        for line in fp:
+            parts = line.split()
+            if len(parts) == 2:
+                ids[int(parts[1])] = int(parts[0])
+
+    return ids
+
+
+def translate_arcs(predecessors, ids):
+    """
+    Translates arcs with the map of read_event_action_ids. Event actions of the replay not in its input schedule
+    keep a distinct id, such that they still order the event actions around them.
+    """
+
+    def translate(event_action):
+        return ids.get(event_action, ('replay', event_action))
+
+    translated = collections.defaultdict(set)
+    for head, tails in predecessors.items():
+        translated[translate(head)].update(translate(tail) for tail in tails)
+
+    return translated
+
+
+def happens_before_closure(ids, predecessors):
+    closure = set()
+    pending = list(ids)
+
+    while pending:
+        event_action = pending.pop()
+        if event_action in closure:
+            continue
+        closure.add(event_action)
+        pending.extend(predecessors.get(event_action, ()))
+
+    return closure
+
+
+# Replay
+
+def read_warnings(path):
+    """
+    Returns the (module, description) of each warning in an errors.log file
+    """
+
+    if not os.path.isfile(path):
+        return []
+
+    with open(path, 'rb') as fp:
+        try:
+            return [(module, description) for _event_action_id, module, description, _details in read_errors_log(fp)]
+        except ErrorsLogFormatError:
+            # A truncated log (e.g. of a crashed replay) does not match any complete one
+            return [('errors.log', 'truncated')]
+
+
+def read_status(path):
+    status = {}
+
+    if os.path.isfile(path):
+        with open(path, 'r', errors='replace') as fp:
+            for line in fp:
+                if ':' in line:
+                    key, value = line.split(':', 1)
+                    status[key.strip()] = value.strip()
+
+    return status
+
+
+class Replayer(object):
+
+    def __init__(self, args, in_dir, work_dir):
+        self.args = args
+        self.in_dir = in_dir
+        self.work_dir = work_dir
+        self.replays = 0
+
+    def run(self, schedule):
+        """
+        Replays schedule and returns its outcome: (result, HTML-hash, sorted warnings)
+        """
+
+        self.replays += 1
+
+        run_dir = os.path.join(self.work_dir, 'replay-%d' % self.replays)
+        os.makedirs(run_dir)
+
+        schedule_path = os.path.join(run_dir, 'schedule.data')
+        schedule.save(schedule_path)
+
+        cmd = [abs_path('clients/Replay/bin/replay'),
+               '-hidewindow',
+               '-timeout', str(self.args.timeout),
+               '-in_dir', self.in_dir + '/',
+               '-out_dir', run_dir]
+
+        if self.args.network_service:
+            cmd.append('-network-service')
+
+        if os.path.isfile(os.path.join(self.in_dir, 'log.storage.data')):
+            cmd.append('-in-memory-storage')
+
+        cmd.extend([self.args.url, schedule_path])
+
+        if self.args.verbose:
+            print('  > %s' % ' '.join(cmd))
+
+        with open(os.path.join(run_dir, 'stdout.txt'), 'wb') as log:
+            subprocess.call(cmd, stdout=log, stderr=subprocess.STDOUT)
+
+        status = read_status(os.path.join(run_dir, 'out.status.data'))
+        warnings = read_warnings(os.path.join(run_dir, 'out.errors.log'))
+
+        outcome = (status.get('Result', 'ERROR'), status.get('HTML-hash', None), tuple(sorted(warnings)))
+
+        if not self.args.keep:
+            shutil.rmtree(run_dir, ignore_errors=True)
+
+        return outcome
+
+
+def start_network_service(log_network_path):
+    """
+    Starts a network service for log_network_path and waits until it serves the log, returns None if it fails
+    """
+
+    service = subprocess.Popen(
+        [abs_path('clients/NetworkService/bin/network-service'), log_network_path],
+        stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+
+    while True:
+        line = service.stdout.readline().decode('utf8', 'ignore')
+
+        if line.startswith('Serving '):
+            return service
+
+        if line == '':
+            service.wait()
+            print('Error, the network service exited with code %d before serving %s' %
+                  (service.returncode, log_network_path), file=sys.stderr)
+            return None
+
+
+def prepare_in_dir(source_dir, in_dir):
+    """
+    The replay reads the recorded logs from in_dir. Logs written by a replay (out.*) are accepted as well.
+    """
+
+    os.makedirs(in_dir)
+
+    for name in LOG_FILES:
+        for candidate in (name, 'out.' + name):
+            path = os.path.join(source_dir, candidate)
+            if os.path.isfile(path):
+                shutil.copy(path, os.path.join(in_dir, name))
+                break
+
+
+# Delta debugging
+
+def ddmin(candidates, test):
+    """
+    Returns a 1-minimal subset of candidates for which test passes. test(candidates) is assumed to pass.
+    """
+
+    if test([]):
+        return []
+
+    keep = list(candidates)
+    n = 2
+
+    while len(keep) >= 2:
+        size = (len(keep) + n - 1) // n
+        chunks = [keep[i:i + size] for i in range(0, len(keep), size)]
+        reduced = False
+
+        for chunk in chunks:
+            if test(chunk):
+                keep = chunk
+                n = 2
+                reduced = True
+                break
+
+        if not reduced:
+            for chunk in chunks:
+                complement = [c for c in keep if c not in chunk]
+                if test(complement):
+                    keep = complement
+                    n = max(n - 1, 2)
+                    reduced = True
+                    break
+
+        if not reduced:
+            if n >= len(keep):
+                break
+            n = min(len(keep), 2 * n)
+
+    return keep
+
+
+def minimize(args):
+    schedule = Schedule.load(args.schedule)
+
+    if args.race is not None:
+        race = tuple(args.race)
+    else:
+        race = schedule.race()
+
+    if None in race:
+        print('Error, no racing pair marked in %s, use --race' % args.schedule, file=sys.stderr)
+        return 1
+
+    ids = schedule.event_action_ids()
+
+    for event_action in race:
+        if event_action not in ids:
+            print('Error, event action %d is not in %s' % (event_action, args.schedule), file=sys.stderr)
+            return 1
+
+    actionlog = args.actionlog
+    id_map = args.id_map
+    if actionlog is None and args.arcs is None:
+        schedule_dir = os.path.dirname(os.path.abspath(args.schedule))
+        replay_actionlog = os.path.join(schedule_dir, 'out.ER_actionlog')
+        replay_ids = os.path.join(schedule_dir, 'out.eventactionids.data')
+
+        if os.path.basename(args.schedule).startswith('out.'):
+            # The output schedule of a replay, numbered like its out.ER_actionlog
+            candidates = [replay_actionlog]
+        else:
+            candidates = [replay_actionlog, os.path.join(schedule_dir, 'ER_actionlog')]
+
+        for candidate in candidates:
+            if os.path.isfile(candidate):
+                actionlog = candidate
+                break
+
+        if actionlog == replay_actionlog and not os.path.basename(args.schedule).startswith('out.') and id_map is None:
+            if not os.path.isfile(replay_ids):
+                print('Error, %s numbers the event actions of the replay, but there is no %s to map them to %s' %
+                      (replay_actionlog, replay_ids, args.schedule), file=sys.stderr)
+                return 1
+            id_map = replay_ids
+
+    if actionlog is None and args.arcs is None:
+        print('Error, no ER_actionlog found next to %s, use --actionlog or --arcs' % args.schedule, file=sys.stderr)
+        return 1
+
+    predecessors = read_arcs(actionlog, args.arcs)
+
+    if id_map is not None:
+        event_action_ids = read_event_action_ids(id_map)
+        replayed = set(event_action_ids.values())
+
+        for event_action in race:
+            if event_action not in replayed:
+                print('Error, event action %d of %s is not in %s, it does not belong to this schedule' %
+                      (event_action, args.schedule, id_map), file=sys.stderr)
+                return 1
+
+        predecessors = translate_arcs(predecessors, event_action_ids)
+
+    # The page load is not always ordered before the event actions it enables in the log.
+    required = set(race)
+    required.update(Schedule.event_action_id(line) for line in schedule.lines
+                    if not Schedule.is_marker(line) and Schedule.event_action_type(line) == 'BrowserLoadUrl')
+    required = happens_before_closure(required, predecessors) & set(ids)
+
+    def closure(keep):
+        return happens_before_closure(keep, predecessors) & set(ids)
+
+    removable = [event_action for event_action in ids if event_action not in required]
+
+    print('%d event actions, %d ordered before the race (%d, %d), %d candidates for removal' %
+          (len(ids), len(required), race[0], race[1], len(removable)))
+
+    work_dir = tempfile.mkdtemp(prefix='webera-minimize-')
+    in_dir = os.path.join(work_dir, 'in')
+    prepare_in_dir(args.in_dir or os.path.dirname(os.path.abspath(args.schedule)), in_dir)
+
+    network_service = None
+    replayer = Replayer(args, in_dir, work_dir)
+
+    try:
+        if args.network_service:
+            network_service = start_network_service(os.path.join(in_dir, 'log.network.data'))
+            if network_service is None:
+                return 1
+
+        reference = replayer.run(schedule)
+        print('Reference: %s, HTML-hash %s, %d warnings' % (reference[0], reference[1], len(reference[2])))
+
+        cache = {}
+
+        def test(keep):
+            kept = frozenset(closure(required | set(keep)))
+
+            if kept not in cache:
+                if replayer.replays > args.max_replays:
+                    cache[kept] = False
+                else:
+                    cache[kept] = replayer.run(schedule.restrict(kept)) == reference
+                    print('  %d event actions: %s' % (len(kept), 'reproduces' if cache[kept] else 'differs'))
+
+            return cache[kept]
+
+        keep = ddmin(removable, test)
+
+        minimized = schedule.restrict(closure(required | set(keep)))
+
+    finally:
+        if network_service is not None:
+            # SIGTERM lets the service release its shared memory segment
+            network_service.terminate()
+            network_service.wait()
+
+        if args.keep:
+            print('Replays kept in %s' % work_dir)
+        else:
+            shutil.rmtree(work_dir, ignore_errors=True)
+
+    minimized.save(args.out)
+
+    print('Minimized schedule: %d of %d event actions after %d replays, written to %s' %
+          (len(minimized.event_action_ids()), len(ids), replayer.replays, args.out))
+
+    if replayer.replays > args.max_replays:
+        print('Warning, the replay limit was reached, the schedule may not be minimal')
+
+    return 0
+
+
+if __name__ == '__main__':
+
+    parser = argparse.ArgumentParser(description='Remove event actions not needed to reproduce a race from a schedule.')
+    parser.add_argument('url', help='the URL of the recorded page')
+    parser.add_argument('schedule', help='the schedule to minimize (e.g. new_schedule.data of a race)')
+    parser.add_argument('--out', default='minimized.schedule.data', help='file for the minimized schedule')
+    parser.add_argument('--race', type=int, nargs=2, metavar=('FIRST', 'SECOND'),
+                        help='ids of the racing event actions (default: read from the <change> and <relax> markers)')
+    parser.add_argument('--actionlog', help='ER_actionlog of the schedule (default: next to the schedule)')
+    parser.add_argument('--arcs', help='read the happens-before arcs from an arcs.log instead of the ER_actionlog')
+    parser.add_argument('--id-map', help='eventactionids.data of the replay that wrote the ER_actionlog or arcs.log, '
+                                         'maps its ids to the ids of the schedule '
+                                         '(default: out.eventactionids.data next to the schedule when its '
+                                         'out.ER_actionlog is used)')
+    parser.add_argument('--in-dir', help='directory with the recorded logs (default: next to the schedule)')
+    parser.add_argument('--network-service', action='store_true',
+                        help='serve the recorded network log to all replays from a network service')
+    parser.add_argument('--timeout', type=int, default=60, help='replay timeout in seconds')
+    parser.add_argument('--max-replays', type=int, default=200, help='stop minimizing after this many replays')
+    parser.add_argument('--keep', action='store_true', help='keep the output of all replays')
+    parser.add_argument('--verbose', action='store_true')
+    sys.exit(minimize(parser.parse_args()))
@@ -46,6 +46,7 @@
 #include "RepatchBuffer.h"
 #include "UStringConcatenate.h"
 #include <stdio.h>
+#include <wtf/ActionLogReport.h>
 #include <wtf/StringExtras.h>
 
 #if ENABLE(DFG_JIT)
@@ -1496,6 +1497,9 @@ CodeBlock::CodeBlock(ScriptExecutable* ownerExecutable, CodeType codeType, JSGlo
 
 CodeBlock::~CodeBlock()
 {
+    // WebERA: Code blocks name the function scopes in the action log.
+    ActionLogUnregisterObject(this);
+
 #if ENABLE(DFG_JIT)
     // Remove myself from the set of DFG code blocks. Note that I may not be in this set
     // (because I'm not a DFG code block), in which case this is a no-op anyway.
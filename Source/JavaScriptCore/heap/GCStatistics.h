@@ -0,0 +1,77 @@
+/*
+ * GCStatistics.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef GCStatistics_h
+#define GCStatistics_h
+
+#include <stddef.h>
+
+namespace JSC {
+
+// WebERA: Histogram of pause times (in seconds).
+//
+// Bucket i counts the pauses shorter than bucketLimit(i), from 0.5ms doubling up to 1s. The last bucket
+// counts all longer pauses.
+class GCPauseHistogram {
+public:
+    static const size_t bucketCount = 13;
+
+    GCPauseHistogram()
+        : m_count(0)
+        , m_total(0)
+        , m_max(0)
+    {
+        for (size_t i = 0; i < bucketCount; ++i)
+            m_buckets[i] = 0;
+    }
+
+    static double bucketLimit(size_t bucket) { return 0.0005 * (1 << bucket); }
+
+    void add(double pause)
+    {
+        size_t bucket = 0;
+        while (bucket < bucketCount - 1 && pause >= bucketLimit(bucket))
+            bucket++;
+        m_buckets[bucket]++;
+        m_count++;
+        m_total += pause;
+        if (pause > m_max)
+            m_max = pause;
+    }
+
+    unsigned bucket(size_t i) const { return m_buckets[i]; }
+    unsigned count() const { return m_count; }
+    double total() const { return m_total; }
+    double max() const { return m_max; }
+
+private:
+    unsigned m_buckets[bucketCount];
+    unsigned m_count;
+    double m_total;
+    double m_max;
+};
+
+// WebERA: Pause times of the garbage collector, see Heap::statistics().
+//
+// Collections are measured from the start of marking until the mutator resumes (including the sweep if it
+// is done eagerly). Sweep slices are the pauses of the incremental sweeper.
+class GCStatistics {
+public:
+    void didCollect(double pause) { m_collections.add(pause); }
+    void didSweepSlice(double pause) { m_sweepSlices.add(pause); }
+
+    const GCPauseHistogram& collections() const { return m_collections; }
+    const GCPauseHistogram& sweepSlices() const { return m_sweepSlices; }
+
+private:
+    GCPauseHistogram m_collections;
+    GCPauseHistogram m_sweepSlices;
+};
+
+} // namespace JSC
+
+#endif // GCStatistics_h
@@ -35,6 +35,7 @@
 #include "Tracing.h"
 #include "WeakSetInlines.h"
 #include <algorithm>
+#include <limits>
 #include <wtf/CurrentTime.h>
 
 
@@ -327,6 +328,8 @@ Heap::Heap(JSGlobalData* globalData, HeapSize heapSize)
     , m_weakSet(this)
     , m_handleSet(globalData)
     , m_isSafeToCollect(false)
+    , m_incrementalSweeping(false)
+    , m_sweeper(this)
     , m_globalData(globalData)
     , m_lastGCLength(0)
     , m_lastCodeDiscardTime(WTF::currentTime())
@@ -338,6 +341,8 @@ Heap::~Heap()
 {
     delete m_markListSet;
 
+    m_sweeper.finishSweeping();
+
     m_objectSpace.shrink();
     m_storageSpace.freeAllBlocks();
 
@@ -361,6 +366,7 @@ void Heap::lastChanceToFinalize()
     if (size_t size = m_protectedValues.size())
         WTFLogAlways("ERROR: JavaScriptCore heap deallocated while %ld values were still protected", static_cast<unsigned long>(size));
 
+    m_sweeper.finishSweeping();
     m_weakSet.finalizeAll();
     canonicalizeCellLivenessData();
     clearMarks();
@@ -779,7 +785,12 @@ void Heap::collect(SweepToggle sweepToggle)
         m_dfgCodeBlocks.deleteUnmarkedJettisonedCodeBlocks();
     }
 
-    if (sweepToggle == DoSweep) {
+    if (m_incrementalSweeping) {
+        // WebERA: Blocks are swept (and empty blocks freed) in slices after the collection.
+        m_sweeper.startSweeping(m_objectSpace.blocks().set());
+        if (sweepToggle == DoSweep)
+            m_weakSet.shrink();
+    } else if (sweepToggle == DoSweep) {
         SamplingRegion samplingRegion("Garbage Collection: Sweeping");
         GCPHASE(Sweeping);
         sweep();
@@ -800,9 +811,49 @@ void Heap::collect(SweepToggle sweepToggle)
     m_bytesAllocated = 0;
     double lastGCEndTime = WTF::currentTime();
     m_lastGCLength = lastGCEndTime - lastGCStartTime;
+    m_statistics.didCollect(m_lastGCLength);
     JAVASCRIPTCORE_GC_END();
 }
 
+// WebERA: Upper bounds of a single incremental sweep slice, such that the sweep stays well below the
+// pauses of a collection.
+static const double idleSweepTimeSlice = 0.005;
+static const double allocationSweepTimeSlice = 0.001;
+
+void Heap::setIncrementalSweeping(bool incrementalSweeping)
+{
+    if (!incrementalSweeping && m_sweeper.isSweeping())
+        sweepSlice(std::numeric_limits<double>::infinity());
+    m_incrementalSweeping = incrementalSweeping;
+}
+
+bool Heap::sweepIncrementally(double deadline)
+{
+    if (!m_sweeper.isSweeping())
+        return true;
+    if (isBusy())
+        return false;
+
+    return sweepSlice(min(deadline, WTF::monotonicallyIncreasingTime() + idleSweepTimeSlice));
+}
+
+void Heap::sweepOnAllocationDemand()
+{
+    if (!m_sweeper.isSweeping())
+        return;
+
+    sweepSlice(WTF::monotonicallyIncreasingTime() + allocationSweepTimeSlice);
+}
+
+bool Heap::sweepSlice(double deadline)
+{
+    SamplingRegion samplingRegion("Garbage Collection: Incremental Sweeping");
+    double sliceStartTime = WTF::monotonicallyIncreasingTime();
+    bool done = m_sweeper.sweepNextBlocks(deadline);
+    m_statistics.didSweepSlice(WTF::monotonicallyIncreasingTime() - sliceStartTime);
+    return done;
+}
+
 void Heap::canonicalizeCellLivenessData()
 {
     m_objectSpace.canonicalizeCellLivenessData();
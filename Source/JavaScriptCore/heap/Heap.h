@@ -24,8 +24,10 @@
 
 #include "BlockAllocator.h"
 #include "DFGCodeBlocks.h"
+#include "GCStatistics.h"
 #include "HandleSet.h"
 #include "HandleStack.h"
+#include "IncrementalSweeper.h"
 #include "MarkedAllocator.h"
 #include "MarkedBlock.h"
 #include "MarkedBlockSet.h"
@@ -123,6 +125,15 @@ namespace JSC {
         bool shouldCollect();
         void collect(SweepToggle);
 
+        // WebERA: Sweep the heap in slices after each collection instead of in the collection pause.
+        // The embedder should call sweepIncrementally() when idle, it returns true once the sweep is done.
+        JS_EXPORT_PRIVATE void setIncrementalSweeping(bool);
+        bool isIncrementalSweeping() const { return m_incrementalSweeping; }
+        JS_EXPORT_PRIVATE bool sweepIncrementally(double deadline);
+        void sweepOnAllocationDemand();
+
+        const GCStatistics& statistics() const { return m_statistics; }
+
         void reportExtraMemoryCost(size_t cost);
         JS_EXPORT_PRIVATE void reportAbandonedObjectGraph();
 
@@ -201,6 +212,7 @@ namespace JSC {
         void finalizeUnconditionalFinalizers();
         
         void sweep();
+        bool sweepSlice(double deadline);
 
         RegisterFile& registerFile();
         BlockAllocator& blockAllocator();
@@ -241,6 +253,10 @@ namespace JSC {
         
         bool m_isSafeToCollect;
 
+        bool m_incrementalSweeping;
+        IncrementalSweeper m_sweeper;
+        GCStatistics m_statistics;
+
         JSGlobalData* m_globalData;
         double m_lastGCLength;
         double m_lastCodeDiscardTime;
@@ -0,0 +1,94 @@
+/*
+ * IncrementalSweeper.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "config.h"
+#include "IncrementalSweeper.h"
+
+#include "Heap.h"
+#include "MarkedBlock.h"
+#include "MarkedSpace.h"
+#include <limits>
+#include <wtf/CurrentTime.h>
+
+namespace JSC {
+
+IncrementalSweeper::IncrementalSweeper(Heap* heap)
+    : m_heap(heap)
+    , m_currentBlockToSweepIndex(0)
+    , m_isSweeping(false)
+{
+}
+
+void IncrementalSweeper::startSweeping(const HashSet<MarkedBlock*>& blockSnapshot)
+{
+    m_blocksToSweep.resize(blockSnapshot.size());
+    HashSet<MarkedBlock*>::const_iterator end = blockSnapshot.end();
+    size_t index = 0;
+    for (HashSet<MarkedBlock*>::const_iterator it = blockSnapshot.begin(); it != end; ++it)
+        m_blocksToSweep[index++] = *it;
+    m_currentBlockToSweepIndex = 0;
+    m_isSweeping = !m_blocksToSweep.isEmpty() || !m_emptyBlocks.isEmpty();
+}
+
+void IncrementalSweeper::finishSweeping()
+{
+    sweepNextBlocks(std::numeric_limits<double>::infinity());
+}
+
+bool IncrementalSweeper::sweepNextBlocks(double deadline)
+{
+    if (!m_isSweeping)
+        return true;
+
+    unsigned blocksSinceTimeCheck = 0;
+    while (m_currentBlockToSweepIndex < m_blocksToSweep.size()) {
+        sweepBlock(m_blocksToSweep[m_currentBlockToSweepIndex++]);
+
+        if (++blocksSinceTimeCheck >= Heap::s_timeCheckResolution) {
+            if (WTF::monotonicallyIncreasingTime() >= deadline)
+                return false;
+            blocksSinceTimeCheck = 0;
+        }
+    }
+
+    // Every dead cell of the snapshot is destroyed, nothing reads the empty blocks any more.
+    freeEmptyBlocks();
+
+    m_blocksToSweep.clear();
+    m_currentBlockToSweepIndex = 0;
+    m_isSweeping = false;
+    return true;
+}
+
+void IncrementalSweeper::sweepBlock(MarkedBlock* block)
+{
+    MarkedSpace& objectSpace = m_heap->objectSpace();
+
+    // Blocks an allocator has swept already hold no dead cells, and the empty blocks of an earlier snapshot are
+    // swept already.
+    if (!objectSpace.blocks().set().contains(block) || !block->needsSweeping() || m_emptyBlocks.contains(block))
+        return;
+
+    block->sweep();
+
+    if (block->markCountIsZero()) {
+        objectSpace.allocatorFor(block).removeBlock(block);
+        m_emptyBlocks.add(block);
+    }
+}
+
+void IncrementalSweeper::freeEmptyBlocks()
+{
+    MarkedSpace& objectSpace = m_heap->objectSpace();
+
+    HashSet<MarkedBlock*>::iterator end = m_emptyBlocks.end();
+    for (HashSet<MarkedBlock*>::iterator it = m_emptyBlocks.begin(); it != end; ++it)
+        objectSpace.freeBlock(*it);
+    m_emptyBlocks.clear();
+}
+
+} // namespace JSC
@@ -0,0 +1,57 @@
+/*
+ * IncrementalSweeper.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef IncrementalSweeper_h
+#define IncrementalSweeper_h
+
+#include "MarkedBlock.h"
+#include <wtf/HashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class Heap;
+
+// WebERA: Sweeps the heap after a collection in short slices instead of in one pause.
+//
+// The sweeper takes a snapshot of the blocks after marking. Each slice runs the destructors of the dead cells
+// in the blocks not swept by an allocator yet and takes the empty blocks away from their allocators. The empty
+// blocks are returned to the block allocator once the whole snapshot is swept: the destructor of a dead cell
+// in a block not swept yet reads its Structure, which may live in one of the empty blocks.
+//
+// Slices are run on allocation demand (before the heap grows) and by the embedder between event actions,
+// see Heap::sweepIncrementally().
+class IncrementalSweeper {
+    WTF_MAKE_NONCOPYABLE(IncrementalSweeper);
+public:
+    explicit IncrementalSweeper(Heap*);
+
+    void startSweeping(const HashSet<MarkedBlock*>&);
+    // Sweeps the rest of the snapshot and frees the empty blocks.
+    void finishSweeping();
+    bool isSweeping() const { return m_isSweeping; }
+
+    // Sweeps blocks until deadline (in monotonic time). Returns true if the sweep is done.
+    bool sweepNextBlocks(double deadline);
+
+private:
+    void sweepBlock(MarkedBlock*);
+    void freeEmptyBlocks();
+
+    Heap* m_heap;
+    Vector<MarkedBlock*> m_blocksToSweep;
+    // Swept blocks without live cells, no longer owned by an allocator. They stay in the snapshot of a
+    // collection that starts before they are freed.
+    HashSet<MarkedBlock*> m_emptyBlocks;
+    size_t m_currentBlockToSweepIndex;
+    bool m_isSweeping;
+};
+
+} // namespace JSC
+
+#endif // IncrementalSweeper_h
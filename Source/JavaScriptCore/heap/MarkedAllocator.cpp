@@ -68,6 +68,10 @@ void* MarkedAllocator::allocateSlowCase()
     if (LIKELY(result != 0))
         return result;
     
+    // WebERA: Continue the sweep of the last collection before growing the heap, such that its empty blocks
+    // can be recycled.
+    m_heap->sweepOnAllocationDemand();
+
     AllocationEffort allocationEffort;
     
     if (m_heap->shouldCollect())
@@ -126,8 +130,9 @@ void MarkedAllocator::addBlock(MarkedBlock* block)
 
 void MarkedAllocator::removeBlock(MarkedBlock* block)
 {
+    // WebERA: The incremental sweeper may take blocks ahead of the current block, keep allocating from the rest.
     if (m_currentBlock == block)
-        m_currentBlock = 0;
+        m_currentBlock = static_cast<MarkedBlock*>(block->next());
     m_blockList.remove(block);
 }
 
@@ -114,6 +114,8 @@ namespace JSC {
 
         enum SweepMode { SweepOnly, SweepToFreeList };
         FreeList sweep(SweepMode = SweepOnly);
+        // WebERA: True if the block holds dead cells of the last collection not swept yet.
+        bool needsSweeping();
 
         // While allocating from a free list, MarkedBlock temporarily has bogus
         // cell liveness data. To restore accurate cell liveness data, call one
@@ -254,6 +256,11 @@ namespace JSC {
         m_state = Marked;
     }
 
+    inline bool MarkedBlock::needsSweeping()
+    {
+        return m_state == Marked;
+    }
+
     inline size_t MarkedBlock::markCount()
     {
         return m_marks.count();
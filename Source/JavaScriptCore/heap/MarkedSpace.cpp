@@ -98,6 +98,14 @@ void MarkedSpace::freeBlocks(MarkedBlock* head)
     }
 }
 
+void MarkedSpace::freeBlock(MarkedBlock* block)
+{
+    m_blocks.remove(block);
+    block->sweep();
+
+    m_heap->blockAllocator().deallocate(block);
+}
+
 class TakeIfUnmarked {
 public:
     typedef MarkedBlock* ReturnType;
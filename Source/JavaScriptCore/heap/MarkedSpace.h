@@ -74,6 +74,8 @@ public:
     
     void shrink();
     void freeBlocks(MarkedBlock* head);
+    // WebERA: Frees a block already removed from its allocator.
+    void freeBlock(MarkedBlock*);
 
     void didAddBlock(MarkedBlock*);
     void didConsumeFreeList(MarkedBlock*);
@@ -103,7 +103,8 @@ void JSCellFieldAccess(ActionLog::CommandType command, JSCell* cell, const char*
 	if (Interpreter::m_jsDomNodeUnwrapper != NULL) {
 		void* ptr1 = Interpreter::m_jsDomNodeUnwrapper(ptr);
 		if (ptr1 != ptr) {
-            ActionLogFormat(command, "DOMNode[%p].%s", ptr, field);
+            // WebERA: The wrapper is named by its logical id, JSNode unregisters it when destroyed.
+            ActionLogFormat(command, "DOMNode[%s].%s", ActionLogObjectName(ptr).data(), field);
 			return;
 		}
     }
@@ -140,8 +141,10 @@ void Interpreter::MemoryValue(ExecState* exec, const JSValue& val) {
 			UString s = cell->getString(exec);
 			if (s.isNull()) {
 				ActionLogReportMemoryValue("null");  // For the strange case of null string, report it as "null".
+			} else if (s.is8Bit()) {
+				ActionLogReportStringValue(s.characters8(), s.length());
 			} else {
-				ActionLogFormat(ActionLog::MEMORY_VALUE, "\"%s\"", s.utf8().data());
+				ActionLogReportStringValue(s.characters16(), s.length());
 			}
 		} else {
 			if (Interpreter::m_jsWindowUnwrapper != NULL) {
@@ -151,7 +154,7 @@ void Interpreter::MemoryValue(ExecState* exec, const JSValue& val) {
 			if (Interpreter::m_jsDomNodeUnwrapper != NULL) {
 				void* ptr1 = Interpreter::m_jsDomNodeUnwrapper(ptr);
 				if (ptr1 != ptr) {
-					ActionLogFormat(ActionLog::MEMORY_VALUE, "DOMNode[%p]", ptr);
+					ActionLogFormat(ActionLog::MEMORY_VALUE, "DOMNode[%s]", ActionLogObjectName(ptr).data());
 					return;
 				}
 			}
@@ -188,7 +191,8 @@ NEVER_INLINE bool Interpreter::resolve(CallFrame* callFrame, Instruction* vPC, J
         JSObject* o = iter->get();
         PropertySlot slot(o);
         if (o->getPropertySlot(callFrame, ident, slot)) {
-        	JSCellFieldAccess(ActionLog::READ_MEMORY, o, ident.ascii().data());
+            if (ActionLogIsActive())
+                JSCellFieldAccess(ActionLog::READ_MEMORY, o, ident.ascii().data());
             JSValue result = slot.getValue(callFrame, ident);
 
             exceptionValue = callFrame->globalData().exception;
@@ -230,7 +234,8 @@ NEVER_INLINE bool Interpreter::resolveSkip(CallFrame* callFrame, Instruction* vP
         JSObject* o = iter->get();
         PropertySlot slot(o);
         if (o->getPropertySlot(callFrame, ident, slot)) {
-        	JSCellFieldAccess(ActionLog::READ_MEMORY, o, ident.ascii().data());
+            if (ActionLogIsActive())
+                JSCellFieldAccess(ActionLog::READ_MEMORY, o, ident.ascii().data());
             JSValue result = slot.getValue(callFrame, ident);
             exceptionValue = callFrame->globalData().exception;
             if (exceptionValue)
@@ -264,7 +269,8 @@ NEVER_INLINE bool Interpreter::resolveGlobal(CallFrame* callFrame, Instruction*
     PropertySlot slot(globalObject);
     if (globalObject->getPropertySlot(callFrame, ident, slot)) {
     	// SRL: Log a read from a global variable.
-    	JSCellFieldAccess(ActionLog::READ_MEMORY, globalObject, ident.ascii().data());
+        if (ActionLogIsActive())
+            JSCellFieldAccess(ActionLog::READ_MEMORY, globalObject, ident.ascii().data());
         JSValue result = slot.getValue(callFrame, ident);
         if (slot.isCacheableValue() && !globalObject->structure()->isUncacheableDictionary() && slot.slotBase() == globalObject) {
             vPC[3].u.structure.set(callFrame->globalData(), codeBlock->ownerExecutable(), globalObject->structure());
@@ -314,7 +320,8 @@ NEVER_INLINE bool Interpreter::resolveGlobalDynamic(CallFrame* callFrame, Instru
             do {
                 PropertySlot slot(o);
                 if (o->getPropertySlot(callFrame, ident, slot)) {
-                	JSCellFieldAccess(ActionLog::READ_MEMORY, o, ident.ascii().data());
+                    if (ActionLogIsActive())
+                        JSCellFieldAccess(ActionLog::READ_MEMORY, o, ident.ascii().data());
                     JSValue result = slot.getValue(callFrame, ident);
                     exceptionValue = callFrame->globalData().exception;
                     if (exceptionValue)
@@ -345,7 +352,8 @@ NEVER_INLINE bool Interpreter::resolveGlobalDynamic(CallFrame* callFrame, Instru
     PropertySlot slot(globalObject);
     if (globalObject->getPropertySlot(callFrame, ident, slot)) {
     	// SRL: Log a read from a global variable.
-    	JSCellFieldAccess(ActionLog::READ_MEMORY, globalObject, ident.ascii().data());
+        if (ActionLogIsActive())
+            JSCellFieldAccess(ActionLog::READ_MEMORY, globalObject, ident.ascii().data());
         JSValue result = slot.getValue(callFrame, ident);
         if (slot.isCacheableValue() && !globalObject->structure()->isUncacheableDictionary() && slot.slotBase() == globalObject) {
             vPC[3].u.structure.set(callFrame->globalData(), codeBlock->ownerExecutable(), globalObject->structure());
@@ -404,7 +412,8 @@ NEVER_INLINE bool Interpreter::resolveBaseAndProperty(CallFrame* callFrame, Inst
         base = iter->get();
         PropertySlot slot(base);
         if (base->getPropertySlot(callFrame, ident, slot)) {
-        	JSCellFieldAccess(ActionLog::READ_MEMORY, base, ident.ascii().data());
+            if (ActionLogIsActive())
+                JSCellFieldAccess(ActionLog::READ_MEMORY, base, ident.ascii().data());
             JSValue result = slot.getValue(callFrame, ident);
             exceptionValue = callFrame->globalData().exception;
             if (exceptionValue)
@@ -443,7 +452,8 @@ NEVER_INLINE bool Interpreter::resolveThisAndProperty(CallFrame* callFrame, Inst
         ++iter;
         PropertySlot slot(base);
         if (base->getPropertySlot(callFrame, ident, slot)) {
-        	JSCellFieldAccess(ActionLog::READ_MEMORY, base, ident.ascii().data());
+            if (ActionLogIsActive())
+                JSCellFieldAccess(ActionLog::READ_MEMORY, base, ident.ascii().data());
             JSValue result = slot.getValue(callFrame, ident);
             exceptionValue = callFrame->globalData().exception;
             if (exceptionValue)
@@ -1777,14 +1787,14 @@ NEVER_INLINE void Interpreter::debug(CallFrame* callFrame, DebugHookID debugHook
 		int lineOffset = callFrame->codeBlock()->source()->startPosition().m_line.zeroBasedInt();
 		const UString& url = callFrame->codeBlock()->source()->url();
 		ActionLogFormat(ActionLog::ENTER_SCOPE,
-				"Exec (fn=%d #%d) line %d-%d %s [[function:%p]]",
+				"Exec (fn=%d #%d) line %d-%d %s [[function:%s]]",
 						callFrame->calleeAsValue() ?
 								static_cast<int>(asObject(callFrame->calleeAsValue())->getCellIndex()) : -1,
 						callFrame->codeBlock()->source()->actionLogJsId(),
 						firstLine - lineOffset,
 						lastLine - lineOffset,
 						url.isNull() ? "?" : url.ascii().data(),
-						static_cast<void*>(callFrame->codeBlock()));
+						ActionLogObjectName(callFrame->codeBlock()).data());
         break;
 	}
     case DidExecuteProgram: {
@@ -1796,14 +1806,14 @@ NEVER_INLINE void Interpreter::debug(CallFrame* callFrame, DebugHookID debugHook
     	int lineOffset = callFrame->codeBlock()->source()->startPosition().m_line.zeroBasedInt();
     	const UString& url = callFrame->codeBlock()->source()->url();
     	ActionLogFormat(ActionLog::ENTER_SCOPE,
-    			"Call (fn=%d #%d) line %d-%d %s [[function:%p]]",
+    			"Call (fn=%d #%d) line %d-%d %s [[function:%s]]",
     					callFrame->calleeAsValue() ?
     							static_cast<int>(asObject(callFrame->calleeAsValue())->getCellIndex()) : -1,
     					callFrame->codeBlock()->source()->actionLogJsId(),
     					firstLine - lineOffset,
     					lastLine - lineOffset,
     					url.isNull() ? "?" : url.ascii().data(),
-    					static_cast<void*>(callFrame->codeBlock()));
+    					ActionLogObjectName(callFrame->codeBlock()).data());
     	break;
     }
     case WillLeaveCallFrame: {
@@ -2116,6 +2126,11 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
     						"?" : callFrame->codeBlock()->ownerExecutable()->sourceURL().utf8().data(),
     				codeTypeToString(callFrame->codeBlock()->codeType())).utf8().data());
 
+    // WebERA: Nothing is logged outside of an event action, which does not change while this invocation runs
+    // (calls between JS functions stay in this loop). Uninstrumented frames skip computing the locations and
+    // values of memory accesses and use the inline caches, which do not log.
+    const bool instrumented = ActionLogIsActive();
+
     JSGlobalData* globalData = &callFrame->globalData();
     JSValue exceptionValue;
     HandlerInfo* handler = 0;
@@ -2148,6 +2163,16 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         tickCount = globalData->timeoutChecker.ticksUntilNextCheck(); \
     }
     
+// WebERA: Cached property accesses are not logged. Instrumented frames drop the cache of the instruction and
+// run it again as the (logging) op_get_by_id or op_put_by_id.
+#define UNCACHE_IF_INSTRUMENTED(uncache) \
+    do { \
+        if (UNLIKELY(instrumented)) { \
+            uncache(codeBlock, vPC); \
+            NEXT_INSTRUCTION(); \
+        } \
+    } while (0)
+
 #if ENABLE(OPCODE_SAMPLING)
     #define SAMPLE(codeBlock, vPC) m_sampler->sample(codeBlock, vPC)
 #else
@@ -3064,8 +3089,10 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         int index = vPC[2].u.operand;
 
         // SRL: Log a global JS variable read.
-        JSCellFieldAccess(ActionLog::READ_MEMORY, scope, scope->symbolTable().resolveReverseSymbolName(index));
-        MemoryValue(callFrame, scope->registerAt(index).get());
+        if (instrumented) {
+            JSCellFieldAccess(ActionLog::READ_MEMORY, scope, scope->symbolTable().resolveReverseSymbolName(index));
+            MemoryValue(callFrame, scope->registerAt(index).get());
+        }
         callFrame->uncheckedR(dst) = scope->registerAt(index).get();
         vPC += OPCODE_LENGTH(op_get_global_var);
         NEXT_INSTRUCTION();
@@ -3081,8 +3108,10 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         int value = vPC[2].u.operand;
 
         // SRL: Log a global JS variable write.
-        JSCellFieldAccess(ActionLog::WRITE_MEMORY, scope, scope->symbolTable().resolveReverseSymbolName(index));
-        MemoryValue(callFrame, callFrame->r(value).jsValue());
+        if (instrumented) {
+            JSCellFieldAccess(ActionLog::WRITE_MEMORY, scope, scope->symbolTable().resolveReverseSymbolName(index));
+            MemoryValue(callFrame, callFrame->r(value).jsValue());
+        }
         scope->registerAt(index).set(*globalData, scope, callFrame->r(value).jsValue());
         vPC += OPCODE_LENGTH(op_put_global_var);
         NEXT_INSTRUCTION();
@@ -3115,8 +3144,10 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         ASSERT((*iter)->isVariableObject());
         JSVariableObject* scope = jsCast<JSVariableObject*>(iter->get());
         // SRL: Log a read.
-        JSCellFieldAccess(ActionLog::READ_MEMORY, scope, scope->symbolTable().resolveReverseSymbolName(index));
-        MemoryValue(callFrame, scope->registerAt(index).get());
+        if (instrumented) {
+            JSCellFieldAccess(ActionLog::READ_MEMORY, scope, scope->symbolTable().resolveReverseSymbolName(index));
+            MemoryValue(callFrame, scope->registerAt(index).get());
+        }
         callFrame->uncheckedR(dst) = scope->registerAt(index).get();
         ASSERT(callFrame->r(dst).jsValue());
         vPC += OPCODE_LENGTH(op_get_scoped_var);
@@ -3150,8 +3181,10 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         JSVariableObject* scope = jsCast<JSVariableObject*>(iter->get());
         ASSERT(callFrame->r(value).jsValue());
         // SRL: Log a write.
-        JSCellFieldAccess(ActionLog::WRITE_MEMORY, scope, scope->symbolTable().resolveReverseSymbolName(index));
-        MemoryValue(callFrame, callFrame->r(value).jsValue());
+        if (instrumented) {
+            JSCellFieldAccess(ActionLog::WRITE_MEMORY, scope, scope->symbolTable().resolveReverseSymbolName(index));
+            MemoryValue(callFrame, callFrame->r(value).jsValue());
+        }
         scope->registerAt(index).set(*globalData, scope, callFrame->r(value).jsValue());
         vPC += OPCODE_LENGTH(op_put_scoped_var);
         NEXT_INSTRUCTION();
@@ -3181,7 +3214,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         Identifier& ident = codeBlock->identifier(property);
         
         JSValue baseVal = callFrame->r(base).jsValue();
-        FieldAccess(ActionLog::READ_MEMORY, baseVal, ident.ascii().data());
+        if (instrumented)
+            FieldAccess(ActionLog::READ_MEMORY, baseVal, ident.ascii().data());
 
         JSObject* baseObject = asObject(baseVal);
         PropertySlot slot(baseVal);
@@ -3240,15 +3274,18 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         Identifier& ident = codeBlock->identifier(property);
         JSValue baseValue = callFrame->r(base).jsValue();
         // SRL: Log a JS object field read.
-        FieldAccess(ActionLog::READ_MEMORY, baseValue, ident.ascii().data());
+        if (instrumented)
+            FieldAccess(ActionLog::READ_MEMORY, baseValue, ident.ascii().data());
         PropertySlot slot(baseValue);
         JSValue result = baseValue.get(callFrame, ident, slot);
         CHECK_FOR_EXCEPTION();
         // SRL: Log the memory value.
-        MemoryValue(callFrame, result);
+        if (instrumented)
+            MemoryValue(callFrame, result);
 
-        // SRL: Do not cache further reads.
-        // tryCacheGetByID(callFrame, codeBlock, vPC, baseValue, ident, slot);
+        // SRL: Do not cache further reads, the cached accesses are not logged.
+        if (!instrumented)
+            tryCacheGetByID(callFrame, codeBlock, vPC, baseValue, ident, slot);
 
         callFrame->uncheckedR(dst) = result;
         vPC += OPCODE_LENGTH(op_get_by_id);
@@ -3261,6 +3298,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
            value base. If the cache misses, op_get_by_id_self reverts to
            op_get_by_id.
         */
+        UNCACHE_IF_INSTRUMENTED(uncacheGetByID);
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
 
@@ -3292,6 +3330,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
            value base's prototype. If the cache misses, op_get_by_id_proto
            reverts to op_get_by_id.
         */
+        UNCACHE_IF_INSTRUMENTED(uncacheGetByID);
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
 
@@ -3331,6 +3370,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
          value base's prototype. If the cache misses, op_get_by_id_getter_proto
          reverts to op_get_by_id.
          */
+        UNCACHE_IF_INSTRUMENTED(uncacheGetByID);
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
         
@@ -3376,6 +3416,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
          from the value base's prototype. If the cache misses, op_get_by_id_custom_proto
          reverts to op_get_by_id.
          */
+        UNCACHE_IF_INSTRUMENTED(uncacheGetByID);
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
         
@@ -3418,6 +3459,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
            value base's prototype chain. If the cache misses, op_get_by_id_chain
            reverts to op_get_by_id.
         */
+        UNCACHE_IF_INSTRUMENTED(uncacheGetByID);
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
 
@@ -3468,6 +3510,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
          value base. If the cache misses, op_get_by_id_getter_self reverts to
          op_get_by_id.
          */
+        UNCACHE_IF_INSTRUMENTED(uncacheGetByID);
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
         
@@ -3511,6 +3554,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
          from the value base. If the cache misses, op_get_by_id_custom_self reverts to
          op_get_by_id.
          */
+        UNCACHE_IF_INSTRUMENTED(uncacheGetByID);
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
         
@@ -3551,12 +3595,14 @@ skip_id_custom_self:
         Identifier& ident = codeBlock->identifier(property);
         JSValue baseValue = callFrame->r(base).jsValue();
         // SRL: Log a JS object field read.
-        FieldAccess(ActionLog::READ_MEMORY, baseValue, ident.ascii().data());
+        if (instrumented)
+            FieldAccess(ActionLog::READ_MEMORY, baseValue, ident.ascii().data());
         PropertySlot slot(baseValue);
         JSValue result = baseValue.get(callFrame, ident, slot);
         CHECK_FOR_EXCEPTION();
         // SRL: Log the memory value read.
-        MemoryValue(callFrame, result);
+        if (instrumented)
+            MemoryValue(callFrame, result);
 
         callFrame->uncheckedR(dst) = result;
         vPC += OPCODE_LENGTH(op_get_by_id_generic);
@@ -3572,6 +3618,7 @@ skip_id_custom_self:
          value base's prototype chain. If the cache misses, op_get_by_id_getter_chain
          reverts to op_get_by_id.
          */
+        UNCACHE_IF_INSTRUMENTED(uncacheGetByID);
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
         
@@ -3627,6 +3674,7 @@ skip_id_custom_self:
          value base's prototype chain. If the cache misses, op_get_by_id_custom_chain
          reverts to op_get_by_id.
          */
+        UNCACHE_IF_INSTRUMENTED(uncacheGetByID);
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
         
@@ -3677,6 +3725,7 @@ skip_id_custom_self:
            and puts the result in register dst. If register base does not hold
            an array, op_get_array_length reverts to op_get_by_id.
         */
+        UNCACHE_IF_INSTRUMENTED(uncacheGetByID);
 
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
@@ -3701,6 +3750,7 @@ skip_id_custom_self:
            and puts the result in register dst. If register base does not hold
            a string, op_get_string_length reverts to op_get_by_id.
         */
+        UNCACHE_IF_INSTRUMENTED(uncacheGetByID);
 
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
@@ -3739,9 +3789,11 @@ skip_id_custom_self:
         JSValue baseValue = callFrame->r(base).jsValue();
         Identifier& ident = codeBlock->identifier(property);
         // SRL: Log a JS object field write.
-        FieldAccess(ActionLog::WRITE_MEMORY, baseValue, ident.ascii().data());
-        // SRL: Log the written memory value.
-        MemoryValue(callFrame, callFrame->r(value).jsValue());
+        if (instrumented) {
+            FieldAccess(ActionLog::WRITE_MEMORY, baseValue, ident.ascii().data());
+            // SRL: Log the written memory value.
+            MemoryValue(callFrame, callFrame->r(value).jsValue());
+        }
         PutPropertySlot slot(codeBlock->isStrictMode());
         if (direct) {
             ASSERT(baseValue.isObject());
@@ -3750,8 +3802,9 @@ skip_id_custom_self:
             baseValue.put(callFrame, ident, callFrame->r(value).jsValue(), slot);
         CHECK_FOR_EXCEPTION();
 
-        // SRL: Do not cache further writes.
-        // tryCachePutByID(callFrame, codeBlock, vPC, baseValue, slot);
+        // SRL: Do not cache further writes, the cached accesses are not logged.
+        if (!instrumented)
+            tryCachePutByID(callFrame, codeBlock, vPC, baseValue, slot);
 
         vPC += OPCODE_LENGTH(op_put_by_id);
         NEXT_INSTRUCTION();
@@ -3772,6 +3825,7 @@ skip_id_custom_self:
            Unlike many opcodes, this one does not write any output to
            the register file.
          */
+        UNCACHE_IF_INSTRUMENTED(uncachePutByID);
         int base = vPC[1].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
         
@@ -3824,6 +3878,7 @@ skip_id_custom_self:
            Unlike many opcodes, this one does not write any output to
            the register file.
         */
+        UNCACHE_IF_INSTRUMENTED(uncachePutByID);
         int base = vPC[1].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
 
@@ -3865,8 +3920,10 @@ skip_id_custom_self:
         JSValue baseValue = callFrame->r(base).jsValue();
         Identifier& ident = codeBlock->identifier(property);
         // SRL: Log a write to the field.
-        FieldAccess(ActionLog::WRITE_MEMORY, baseValue, ident.ascii().data());
-        MemoryValue(callFrame, callFrame->r(value).jsValue());
+        if (instrumented) {
+            FieldAccess(ActionLog::WRITE_MEMORY, baseValue, ident.ascii().data());
+            MemoryValue(callFrame, callFrame->r(value).jsValue());
+        }
         PutPropertySlot slot(codeBlock->isStrictMode());
         if (direct) {
             ASSERT(baseValue.isObject());
@@ -3893,9 +3950,10 @@ skip_id_custom_self:
         JSObject* baseObj = callFrame->r(base).jsValue().toObject(callFrame);
         Identifier& ident = codeBlock->identifier(property);
         // SRL: Log a JS object field write for field deletion.
-        FieldAccess(ActionLog::WRITE_MEMORY, callFrame->r(base).jsValue(), ident.ascii().data());
-        if (ActionLogWillAddCommand(ActionLog::MEMORY_VALUE)) {
-        	ActionLogReportMemoryValue("undefined");
+        if (instrumented) {
+            FieldAccess(ActionLog::WRITE_MEMORY, callFrame->r(base).jsValue(), ident.ascii().data());
+            if (ActionLogWillAddCommand(ActionLog::MEMORY_VALUE))
+                ActionLogReportMemoryValue("undefined");
         }
         bool result = baseObj->methodTable()->deleteProperty(baseObj, callFrame, ident);
         if (!result && codeBlock->isStrictMode()) {
@@ -3930,12 +3988,14 @@ skip_id_custom_self:
         {
             Identifier propertyName(callFrame, subscript.toString(callFrame)->value(callFrame));
             // SRL: Log a JS object field read.
-            FieldAccess(ActionLog::READ_MEMORY, baseValue, propertyName.ascii().data());
+            if (instrumented)
+                FieldAccess(ActionLog::READ_MEMORY, baseValue, propertyName.ascii().data());
             result = baseValue.get(callFrame, propertyName);
         }
         CHECK_FOR_EXCEPTION();
         // SRL: Log the memory value read.
-        MemoryValue(callFrame, result);
+        if (instrumented)
+            MemoryValue(callFrame, result);
         callFrame->uncheckedR(dst) = result;
         vPC += OPCODE_LENGTH(op_get_by_pname);
         NEXT_INSTRUCTION();
@@ -4005,17 +4065,19 @@ skip_id_custom_self:
             else
                 result = baseValue.get(callFrame, i);
             // SRL: Log a JS array write.
-            if (baseValue.isCell()) {
+            if (instrumented && baseValue.isCell()) {
             	ActionLogReportArrayRead(baseValue.asCell()->getCellIndex(), i);
             	MemoryValue(callFrame, result);
             }
         } else {
             Identifier property(callFrame, subscript.toString(callFrame)->value(callFrame));
             // SRL: Log a JS object field read.
-            FieldAccess(ActionLog::READ_MEMORY, baseValue, property.ascii().data());
+            if (instrumented)
+                FieldAccess(ActionLog::READ_MEMORY, baseValue, property.ascii().data());
             result = baseValue.get(callFrame, property);
             // SRL: Log the memory value read.
-            MemoryValue(callFrame, result);
+            if (instrumented)
+                MemoryValue(callFrame, result);
         }
 
         CHECK_FOR_EXCEPTION();
@@ -4052,7 +4114,7 @@ skip_id_custom_self:
             } else
                 baseValue.putByIndex(callFrame, i, callFrame->r(value).jsValue(), codeBlock->isStrictMode());
             // SRL: Log a JS array write.
-            if (baseValue.isCell()) {
+            if (instrumented && baseValue.isCell()) {
             	ActionLogReportArrayWrite(baseValue.asCell()->getCellIndex(), i);
             	MemoryValue(callFrame, callFrame->r(value).jsValue());
             }
@@ -4060,9 +4122,11 @@ skip_id_custom_self:
             Identifier property(callFrame, subscript.toString(callFrame)->value(callFrame));
             if (!globalData->exception) { // Don't put to an object if toString threw an exception.
             	// SRL: Log a JS object field write.
-            	FieldAccess(ActionLog::WRITE_MEMORY, baseValue, property.ascii().data());
-                // SRL: Log the written memory value.
-                MemoryValue(callFrame, callFrame->r(value).jsValue());
+                if (instrumented) {
+                    FieldAccess(ActionLog::WRITE_MEMORY, baseValue, property.ascii().data());
+                    // SRL: Log the written memory value.
+                    MemoryValue(callFrame, callFrame->r(value).jsValue());
+                }
                 PutPropertySlot slot(codeBlock->isStrictMode());
                 baseValue.put(callFrame, property, callFrame->r(value).jsValue(), slot);
             }
@@ -4092,18 +4156,20 @@ skip_id_custom_self:
         if (subscript.getUInt32(i)) {
             result = baseObj->methodTable()->deletePropertyByIndex(baseObj, callFrame, i);
             // SRL: Log a JS array write.
-           	ActionLogReportArrayWrite(baseObj->getCellIndex(), i);
-            if (ActionLogWillAddCommand(ActionLog::MEMORY_VALUE)) {
-            	ActionLogReportMemoryValue("undefined");
+            if (instrumented) {
+                ActionLogReportArrayWrite(baseObj->getCellIndex(), i);
+                if (ActionLogWillAddCommand(ActionLog::MEMORY_VALUE))
+                    ActionLogReportMemoryValue("undefined");
             }
         } else {
             CHECK_FOR_EXCEPTION();
             Identifier property(callFrame, subscript.toString(callFrame)->value(callFrame));
             CHECK_FOR_EXCEPTION();
             // SRL: Log a JS object field write.
-            FieldAccess(ActionLog::WRITE_MEMORY, callFrame->r(base).jsValue(), property.ascii().data());
-            if (ActionLogWillAddCommand(ActionLog::MEMORY_VALUE)) {
-            	ActionLogReportMemoryValue("undefined");
+            if (instrumented) {
+                FieldAccess(ActionLog::WRITE_MEMORY, callFrame->r(base).jsValue(), property.ascii().data());
+                if (ActionLogWillAddCommand(ActionLog::MEMORY_VALUE))
+                    ActionLogReportMemoryValue("undefined");
             }
             result = baseObj->methodTable()->deleteProperty(baseObj, callFrame, property);
         }
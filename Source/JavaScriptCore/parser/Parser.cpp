@@ -29,6 +29,7 @@
 #include "JSGlobalData.h"
 #include "Lexer.h"
 #include "NodeInfo.h"
+#include "PersistentSourceProviderCache.h"
 #include "SourceProvider.h"
 #include <utility>
 #include <wtf/HashFunctions.h>
@@ -62,6 +63,9 @@ Parser<LexerType>::Parser(JSGlobalData* globalData, const SourceCode& source, Fu
     m_lexer->setCode(source, m_arena);
 
     m_functionCache = source.provider()->cache();
+    // WebERA: Reuse the function info cached by earlier runs on this script
+    if (m_functionCache)
+        PersistentSourceProviderCache::load(globalData, source.provider());
     ScopeFlags scopeFlags = NoScopeFlags;
     if (strictness == JSParseStrict)
         scopeFlags |= StrictModeFlag;
@@ -99,8 +103,10 @@ UString Parser<LexerType>::parseInner()
     scope->getCapturedVariables(capturedVariables);
     ScopeFlags scopeFlags = scope->modeFlags() | scope->usesFlags();
     unsigned functionCacheSize = m_functionCache ? m_functionCache->byteSize() : 0;
-    if (functionCacheSize != oldFunctionCacheSize)
+    if (functionCacheSize != oldFunctionCacheSize) {
         m_lexer->sourceProvider()->notifyCacheSizeChanged(functionCacheSize - oldFunctionCacheSize);
+        PersistentSourceProviderCache::save(m_lexer->sourceProvider());
+    }
 
     didFinishParsing(sourceElements, context.varDeclarations(), context.funcDeclarations(), scopeFlags,
                      m_lastLine, context.numConstants(), capturedVariables);
@@ -0,0 +1,346 @@
+/*
+ * PersistentSourceProviderCache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "config.h"
+#include "PersistentSourceProviderCache.h"
+
+#include "Identifier.h"
+#include "SourceProvider.h"
+#include "SourceProviderCache.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <wtf/Vector.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/WTFString.h>
+
+#if OS(UNIX)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if OS(LINUX) || OS(DARWIN)
+#include <dlfcn.h>
+#endif
+
+namespace JSC {
+
+namespace {
+
+const char cacheMagic[4] = { 'E', 'R', 'J', 'C' };
+const uint32_t cacheVersion = 2;
+
+String* s_directory = 0;
+CString* s_buildId = 0;
+
+// Cached function info refers to the identifier layout and scope flags of the parser that produced it. The
+// parser is identified by the binary it was loaded from (its path, size and modification time), such that
+// any rebuild invalidates the cache. Returns an empty id if the binary can not be found.
+CString computeBuildId()
+{
+#if OS(LINUX) || OS(DARWIN)
+    Dl_info info;
+    if (!dladdr(reinterpret_cast<void*>(&computeBuildId), &info) || !info.dli_fname)
+        return CString();
+
+    struct stat binary;
+    if (stat(info.dli_fname, &binary))
+        return CString();
+
+    char id[64];
+    snprintf(id, sizeof(id), ":%lld:%lld", static_cast<long long>(binary.st_size), static_cast<long long>(binary.st_mtime));
+    return (String::fromUTF8(info.dli_fname) + id).utf8();
+#else
+    return CString();
+#endif
+}
+
+String cachePath(SourceProvider* provider)
+{
+    const StringImpl* source = provider->data();
+    const UChar* characters = source->characters();
+    unsigned length = source->length();
+
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned i = 0; i < length; ++i) {
+        hash = (hash ^ (characters[i] & 0xFF)) * 1099511628211ULL;
+        hash = (hash ^ (characters[i] >> 8)) * 1099511628211ULL;
+    }
+
+    char name[64];
+    snprintf(name, sizeof(name), "/%016llx-%u.jsfc", static_cast<unsigned long long>(hash), length);
+    return *s_directory + name;
+}
+
+// Line numbers are stored relative to the first line of the script, an inline script with the same contents
+// may start at a different line of another page.
+int firstLine(SourceProvider* provider)
+{
+    return provider->startPosition().m_line.oneBasedInt();
+}
+
+class CacheReader {
+public:
+    CacheReader(const char* data, size_t size)
+        : m_data(data)
+        , m_size(size)
+        , m_position(0)
+    {
+    }
+
+    bool atEnd() const { return m_position == m_size; }
+
+    bool read(void* value, size_t size)
+    {
+        if (m_size - m_position < size)
+            return false;
+        memcpy(value, m_data + m_position, size);
+        m_position += size;
+        return true;
+    }
+
+    bool readUInt32(uint32_t* value) { return read(value, sizeof(*value)); }
+
+    bool readIdentifiers(JSGlobalData* globalData, Vector<RefPtr<StringImpl> >* identifiers)
+    {
+        uint32_t count;
+        if (!readUInt32(&count))
+            return false;
+
+        Vector<UChar> characters;
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t length;
+            if (!readUInt32(&length) || (m_size - m_position) / sizeof(UChar) < length)
+                return false;
+            characters.resize(length);
+            read(characters.data(), length * sizeof(UChar));
+            identifiers->append(Identifier(globalData, characters.data(), length).impl());
+        }
+        return true;
+    }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_position;
+};
+
+void append(Vector<char>* buffer, const void* value, size_t size)
+{
+    buffer->append(static_cast<const char*>(value), size);
+}
+
+void appendUInt32(Vector<char>* buffer, uint32_t value)
+{
+    append(buffer, &value, sizeof(value));
+}
+
+void appendIdentifiers(Vector<char>* buffer, const Vector<RefPtr<StringImpl> >& identifiers)
+{
+    appendUInt32(buffer, identifiers.size());
+    for (size_t i = 0; i < identifiers.size(); ++i) {
+        appendUInt32(buffer, identifiers[i]->length());
+        append(buffer, identifiers[i]->characters(), identifiers[i]->length() * sizeof(UChar));
+    }
+}
+
+void appendHeader(Vector<char>* buffer, SourceProvider* provider)
+{
+    append(buffer, cacheMagic, sizeof(cacheMagic));
+    appendUInt32(buffer, cacheVersion);
+    appendUInt32(buffer, s_buildId->length());
+    append(buffer, s_buildId->data(), s_buildId->length());
+    appendUInt32(buffer, provider->length());
+}
+
+// The file is a header followed by items, appended by each run that adds function info. Items of parallel
+// runs may repeat, the first copy wins.
+// Returns the number of items added to cache.
+unsigned loadItems(JSGlobalData* globalData, SourceProvider* provider, SourceProviderCache* cache, const char* data, size_t size)
+{
+    CacheReader reader(data, size);
+    unsigned loaded = 0;
+
+    char magic[sizeof(cacheMagic)];
+    uint32_t version;
+    if (!reader.read(magic, sizeof(magic)) || memcmp(magic, cacheMagic, sizeof(magic)) || !reader.readUInt32(&version) || version != cacheVersion)
+        return loaded;
+
+    uint32_t buildIdLength;
+    if (!reader.readUInt32(&buildIdLength) || buildIdLength != s_buildId->length())
+        return loaded;
+    Vector<char> storedBuildId(buildIdLength);
+    if (!reader.read(storedBuildId.data(), buildIdLength) || memcmp(storedBuildId.data(), s_buildId->data(), buildIdLength))
+        return loaded;
+
+    uint32_t sourceLength;
+    if (!reader.readUInt32(&sourceLength) || sourceLength != static_cast<uint32_t>(provider->length()))
+        return loaded;
+
+    const UChar* source = provider->data()->characters();
+
+    while (!reader.atEnd()) {
+        int32_t openBracePos;
+        int32_t closeBraceLine;
+        int32_t closeBracePos;
+        uint16_t scopeFlags;
+        if (!reader.read(&openBracePos, sizeof(openBracePos)) || !reader.read(&closeBraceLine, sizeof(closeBraceLine))
+            || !reader.read(&closeBracePos, sizeof(closeBracePos)) || !reader.read(&scopeFlags, sizeof(scopeFlags)))
+            return loaded;
+
+        // Guards against hash collisions, the parser trusts the cache without further checks.
+        if (openBracePos < 0 || closeBracePos <= openBracePos || static_cast<uint32_t>(closeBracePos) >= sourceLength
+            || source[openBracePos] != '{' || source[closeBracePos] != '}')
+            return loaded;
+
+        OwnPtr<SourceProviderCacheItem> item = adoptPtr(new SourceProviderCacheItem(firstLine(provider) + closeBraceLine, closeBracePos));
+        item->scopeFlags = scopeFlags;
+        if (!reader.readIdentifiers(globalData, &item->usedVariables) || !reader.readIdentifiers(globalData, &item->writtenVariables))
+            return loaded;
+
+        if (cache->get(openBracePos))
+            continue;
+
+        unsigned approximateByteSize = item->approximateByteSize();
+        cache->add(openBracePos, item.release(), approximateByteSize);
+        loaded++;
+    }
+
+    return loaded;
+}
+
+}
+
+void PersistentSourceProviderCache::setDirectory(const String& directory)
+{
+    if (!s_directory) {
+        s_directory = new String;
+        s_buildId = new CString(computeBuildId());
+    }
+    *s_directory = directory;
+}
+
+bool PersistentSourceProviderCache::isEnabled()
+{
+    return s_directory && !s_directory->isEmpty() && s_buildId->length();
+}
+
+void PersistentSourceProviderCache::load(JSGlobalData* globalData, SourceProvider* provider)
+{
+    SourceProviderCache* cache = provider->cache();
+    if (!isEnabled() || !cache || cache->m_persistentLoaded || !provider->data())
+        return;
+    cache->m_persistentLoaded = true;
+
+    // Items read from disk are not saved again.
+    size_t unsavedItems = cache->m_unsavedPositions.size();
+
+    CString path = cachePath(provider).utf8();
+
+#if OS(UNIX)
+    int fd = open(path.data(), O_RDONLY);
+    if (fd == -1)
+        return;
+
+    struct stat info;
+    if (fstat(fd, &info) || !info.st_size) {
+        close(fd);
+        return;
+    }
+
+    void* data = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return;
+
+    loadItems(globalData, provider, cache, static_cast<const char*>(data), info.st_size);
+    munmap(data, info.st_size);
+#else
+    FILE* f = fopen(path.data(), "rb");
+    if (!f)
+        return;
+
+    Vector<char> data;
+    char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), f)) > 0)
+        data.append(buffer, read);
+    fclose(f);
+
+    loadItems(globalData, provider, cache, data.data(), data.size());
+#endif
+
+    cache->m_unsavedPositions.shrink(unsavedItems);
+}
+
+void PersistentSourceProviderCache::save(SourceProvider* provider)
+{
+    SourceProviderCache* cache = provider->cache();
+    if (!isEnabled() || !cache || !provider->data() || cache->m_unsavedPositions.isEmpty())
+        return;
+
+    // Only the items added since the last load or save are appended.
+    Vector<char> items;
+    for (size_t i = 0; i < cache->m_unsavedPositions.size(); ++i) {
+        int32_t openBracePos = cache->m_unsavedPositions[i];
+        const SourceProviderCacheItem* item = cache->get(openBracePos);
+        if (!item)
+            continue;
+        int32_t closeBraceLine = item->closeBraceLine - firstLine(provider);
+        int32_t closeBracePos = item->closeBracePos;
+        uint16_t scopeFlags = item->scopeFlags;
+        append(&items, &openBracePos, sizeof(openBracePos));
+        append(&items, &closeBraceLine, sizeof(closeBraceLine));
+        append(&items, &closeBracePos, sizeof(closeBracePos));
+        append(&items, &scopeFlags, sizeof(scopeFlags));
+        appendIdentifiers(&items, item->usedVariables);
+        appendIdentifiers(&items, item->writtenVariables);
+    }
+
+    CString path = cachePath(provider).utf8();
+    Vector<char> header;
+    appendHeader(&header, provider);
+
+#if OS(UNIX)
+    int fd = open(path.data(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd == -1)
+        return;
+
+    // Parallel replays of the same site share the directory, the lock keeps their items (and the header of a
+    // new file) from interleaving.
+    struct stat info;
+    bool ok = !flock(fd, LOCK_EX) && !fstat(fd, &info);
+    if (ok && !info.st_size)
+        items.insert(0, header.data(), header.size());
+    if (ok && write(fd, items.data(), items.size()) != static_cast<ssize_t>(items.size())) {
+        // Drop a partial write, later items would be appended after it.
+        int truncated = ftruncate(fd, info.st_size);
+        UNUSED_PARAM(truncated);
+        ok = false;
+    }
+    close(fd);
+#else
+    FILE* f = fopen(path.data(), "ab");
+    if (!f)
+        return;
+
+    bool ok = !fseek(f, 0, SEEK_END);
+    if (ok && !ftell(f))
+        ok = fwrite(header.data(), 1, header.size(), f) == header.size();
+    ok = ok && fwrite(items.data(), 1, items.size(), f) == items.size();
+    ok = !fclose(f) && ok;
+#endif
+
+    if (ok)
+        cache->m_unsavedPositions.clear();
+}
+
+}
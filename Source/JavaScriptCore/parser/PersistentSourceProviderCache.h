@@ -0,0 +1,39 @@
+/*
+ * PersistentSourceProviderCache.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef PersistentSourceProviderCache_h
+#define PersistentSourceProviderCache_h
+
+#include <wtf/Forward.h>
+
+namespace JSC {
+
+class JSGlobalData;
+class SourceProvider;
+
+// WebERA: On-disk copy of the SourceProviderCache, shared by all runs (record, replays) of the same site.
+//
+// The function info the parser caches to skip function bodies (see Parser::parseFunctionInfo) is appended to
+// <directory>/<content hash>-<length>.jsfc, keyed by the contents of the script and the binary of the parser.
+// Later runs load it before parsing the script the first time, such that lazily compiled functions are not
+// parsed twice and repeated scripts skip the body of every cached function.
+//
+// The cache is disabled until a directory is set, and on platforms where the binary can not be identified.
+class PersistentSourceProviderCache {
+public:
+    JS_EXPORT_PRIVATE static void setDirectory(const String& directory);
+    static bool isEnabled();
+
+    // Loads the cached function info of provider into its SourceProviderCache. Only done once per cache.
+    static void load(JSGlobalData*, SourceProvider*);
+    // Appends the function info added to the SourceProviderCache of provider since it was last loaded or saved.
+    static void save(SourceProvider*);
+};
+
+}
+
+#endif // PersistentSourceProviderCache_h
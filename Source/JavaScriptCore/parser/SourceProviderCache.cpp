@@ -37,6 +37,8 @@ void SourceProviderCache::clear()
 {
     m_map.clear();
     m_contentByteSize = 0;
+    m_persistentLoaded = false;
+    m_unsavedPositions.clear();
 }
 
 unsigned SourceProviderCache::byteSize() const
@@ -46,7 +48,8 @@ unsigned SourceProviderCache::byteSize() const
 
 void SourceProviderCache::add(int sourcePosition, PassOwnPtr<SourceProviderCacheItem> item, unsigned size)
 {
-    m_map.add(sourcePosition, item);
+    if (m_map.add(sourcePosition, item).isNewEntry)
+        m_unsavedPositions.append(sourcePosition);
     m_contentByteSize += size;
 }
 
@@ -30,12 +30,13 @@
 #include <wtf/HashMap.h>
 #include <wtf/OwnPtr.h>
 #include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
 
 namespace JSC {
 
 class SourceProviderCache {
 public:
-    SourceProviderCache() : m_contentByteSize(0) {}
+    SourceProviderCache() : m_contentByteSize(0), m_persistentLoaded(false) {}
     JS_EXPORT_PRIVATE ~SourceProviderCache();
 
     JS_EXPORT_PRIVATE void clear();
@@ -44,8 +45,14 @@ public:
     const SourceProviderCacheItem* get(int sourcePosition) const { return m_map.get(sourcePosition); }
 
 private:
+    friend class PersistentSourceProviderCache;
+
     HashMap<int, OwnPtr<SourceProviderCacheItem> > m_map;
     unsigned m_contentByteSize;
+
+    // WebERA: State of the on-disk copy of this cache, see PersistentSourceProviderCache.
+    bool m_persistentLoaded;
+    Vector<int> m_unsavedPositions;
 };
 
 }
@@ -648,9 +648,8 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncSlice(ExecState* exec)
     // SRL: Report array reads.
     ActionLogScope scope("array:slice");
     ActionLogReportArrayReadLen(thisObj->getCellIndex());
-    for (unsigned k = begin; k < end; k++) {
-    	ActionLogReportArrayReadScan(thisObj->getCellIndex(), k);
-	}
+    if (begin < end)
+        ActionLogReportArrayReadRange(thisObj->getCellIndex(), begin, end - begin);
 
     unsigned n = 0;
     for (unsigned k = begin; k < end; k++, n++) {
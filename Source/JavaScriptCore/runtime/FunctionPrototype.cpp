@@ -153,9 +153,7 @@ EncodedJSValue JSC_HOST_CALL functionProtoFuncApply(ExecState* exec)
         // SRL: Report array reads.
         ActionLogScope scope("function:apply");
         ActionLogReportArrayReadLen(asObject(array)->getCellIndex());
-        for (size_t k = 0; k < applyArgs.size(); k++) {
-        	ActionLogReportArrayReadScan(asObject(array)->getCellIndex(), k);
-    	}
+        ActionLogReportArrayReadRange(asObject(array)->getCellIndex(), 0, applyArgs.size());
     }
     
     return JSValue::encode(call(exec, thisValue, callType, callData, exec->argument(0), applyArgs));
@@ -162,8 +162,12 @@ HEADERS += \
     StringSet.h \
     ActionLog.h \
     ActionLogReport.h \
+    ActionLogEncoding.h \
+    ActionLogSummary.h \
+    LittleEndianIO.h \
     EventActionSchedule.h \
     EventActionDescriptor.h \
+    SequenceRegistry.h \
     wtf/warningcollector.h \
     wtf/warningcollectorreport.h
 
@@ -223,8 +227,11 @@ SOURCES += \
     StringSet.cpp \
     ActionLog.cpp \
     ActionLogReport.cpp \
+    ActionLogEncoding.cpp \
+    ActionLogSummary.cpp \
     EventActionSchedule.cpp \
     EventActionDescriptor.cpp \
+    SequenceRegistry.cpp \
     wtf/warningcollector.cpp \
     wtf/warningcollectorreport.cpp
 
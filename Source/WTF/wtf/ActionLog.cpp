@@ -6,7 +6,10 @@
  */
 
 #include "ActionLog.h"
+#include "ActionLogEncoding.h"
+#include "StringSet.h"
 #include <iostream>
+#include <string>
 
 const char* ActionLog::CommandType_AsString(CommandType ctype) {
 	switch (ctype) {
@@ -16,6 +19,8 @@ const char* ActionLog::CommandType_AsString(CommandType ctype) {
 	case WRITE_MEMORY: return "WRITE_MEMORY";
 	case TRIGGER_ARC: return "TRIGGER_ARC";
 	case MEMORY_VALUE: return "MEMORY_VALUE";
+	case READ_RANGE: return "READ_RANGE";
+	case WRITE_RANGE: return "WRITE_RANGE";
 	}
 	return "CommandType:OTHER";
 }
@@ -64,6 +69,10 @@ void ActionLog::startEventAction(int operation) {
 
 bool ActionLog::endEventAction() {
 	bool wasInOp = m_currentEventActionId != -1;
+	if (wasInOp) {
+		// Event action ids are not reused, no more objects are named after this one.
+		m_objectOrdinals.erase(m_currentEventActionId);
+	}
 	m_currentEventActionId = -1;
 	m_cmdsInCurrentEvent.clear();
 	m_scopeDepth = 0;
@@ -95,7 +104,7 @@ bool ActionLog::logCommand(CommandType command, int memoryLocation) {
 	Command c;
 	c.m_cmdType = command;
 	c.m_location = memoryLocation;
-	if (command == READ_MEMORY || command == WRITE_MEMORY) {
+	if (command == READ_MEMORY || command == WRITE_MEMORY || command == READ_RANGE || command == WRITE_RANGE) {
 		if (!m_cmdsInCurrentEvent.insert(c).second) {
 			return true;  // Already exists, no need to add again to the same op.
 		}
@@ -135,6 +144,55 @@ void ActionLog::eventTriggered(void* eventId) {
 	m_pendingTriggerArcs.erase(it);
 }
 
+void ActionLog::expandRanges(StringSet* variableSet) {
+	for (EventActionSet::iterator it = m_eventActions.begin(); it != m_eventActions.end(); ++it) {
+		std::vector<Command>& commands = it->second->m_commands;
+
+		bool hasRanges = false;
+		for (size_t i = 0; i < commands.size() && !hasRanges; ++i) {
+			hasRanges = commands[i].m_cmdType == READ_RANGE || commands[i].m_cmdType == WRITE_RANGE;
+		}
+		if (!hasRanges) continue;
+
+		std::vector<Command> expanded;
+		expanded.reserve(commands.size());
+		std::set<Command> accesses;
+
+		for (size_t i = 0; i < commands.size(); ++i) {
+			const Command& c = commands[i];
+			if (c.m_cmdType != READ_RANGE && c.m_cmdType != WRITE_RANGE) {
+				if (c.m_cmdType == READ_MEMORY || c.m_cmdType == WRITE_MEMORY) {
+					accesses.insert(c);
+				}
+				expanded.push_back(c);
+				continue;
+			}
+
+			// Copied, getString() is invalidated by adding the names of the locations.
+			std::string name = variableSet->getString(c.m_location);
+			size_t open = name.rfind('[');
+			int start, length;
+			if (open == std::string::npos || sscanf(name.c_str() + open, "[%d:%d]", &start, &length) != 2) {
+				continue;
+			}
+			std::string base = name.substr(0, open);
+
+			Command access;
+			access.m_cmdType = c.m_cmdType == READ_RANGE ? READ_MEMORY : WRITE_MEMORY;
+			for (int index = start; index < start + length; ++index) {
+				char suffix[32];
+				snprintf(suffix, sizeof(suffix), "[%d]", index);
+				access.m_location = variableSet->addString((base + suffix).c_str());
+				if (accesses.insert(access).second) {
+					expanded.push_back(access);
+				}
+			}
+		}
+
+		commands.swap(expanded);
+	}
+}
+
 struct ActionLogHeader {
 	int num_ops;
 	int num_arcs;
@@ -188,3 +246,53 @@ bool ActionLog::loadFromFile(FILE* f) {
 	return true;
 }
 
+
+void ActionLog::saveToEncoder(ActionLogEncoder* encoder) {
+	encoder->writeVarint(m_arcs.size());
+	for (size_t i = 0; i < m_arcs.size(); ++i) {
+		encoder->writeArc(m_arcs[i]);
+	}
+	encoder->writeVarint(m_eventActions.size());
+	for (EventActionSet::const_iterator it = m_eventActions.begin(); it != m_eventActions.end(); ++it) {
+		const EventAction& op = *(it->second);
+		encoder->writeEventActionHeader(it->first, op.m_type, op.m_commands.size());
+		for (size_t i = 0; i < op.m_commands.size(); ++i) {
+			encoder->writeCommand(op.m_commands[i]);
+		}
+	}
+}
+
+bool ActionLog::loadFromDecoder(ActionLogDecoder* decoder) {
+	uint32_t n = 0;
+	if (!decoder->readVarint(&n)) return false;
+	m_arcs.resize(n);
+	for (size_t i = 0; i < m_arcs.size(); ++i) {
+		if (!decoder->readArc(&m_arcs[i])) return false;
+	}
+	if (!decoder->readVarint(&n)) return false;
+	for (uint32_t i = 0; i < n; ++i) {
+		int id;
+		EventActionType type;
+		int numCommands;
+		if (!decoder->readEventActionHeader(&id, &type, &numCommands)) return false;
+		EventAction* op = new EventAction();
+		op->m_type = type;
+		op->m_commands.resize(numCommands);
+		m_eventActions[id] = op;
+		for (int j = 0; j < numCommands; ++j) {
+			if (!decoder->readCommand(&op->m_commands[j])) return false;
+		}
+		if (id > m_maxEventActionId) {
+			m_maxEventActionId = id;
+		}
+	}
+	return true;
+}
+
+size_t ActionLog::numCommands() const {
+	size_t n = 0;
+	for (EventActionSet::const_iterator it = m_eventActions.begin(); it != m_eventActions.end(); ++it) {
+		n += it->second->m_commands.size();
+	}
+	return n;
+}
@@ -13,6 +13,10 @@
 #include <set>
 #include <vector>
 
+class ActionLogEncoder;
+class ActionLogDecoder;
+class StringSet;
+
 class ActionLog {
 public:
 	ActionLog();
@@ -24,7 +28,11 @@ public:
 		READ_MEMORY,
 		WRITE_MEMORY,
 		TRIGGER_ARC,
-		MEMORY_VALUE
+		MEMORY_VALUE,
+		// Reads or writes of the consecutive locations <base>[start] .. <base>[start + length - 1], the
+		// location is named "<base>[start:length]". See expandRanges().
+		READ_RANGE,
+		WRITE_RANGE
 	};
 	static const char* CommandType_AsString(CommandType ctype);
 
@@ -77,12 +85,21 @@ public:
 	// previous call of triggerEvent with the same eventId.
 	void eventTriggered(void* eventId);
 
+	// Replaces each READ_RANGE and WRITE_RANGE command by a READ_MEMORY or WRITE_MEMORY command for every
+	// location in the range, for consumers that do not know range commands (e.g. the race detector).
+	// The names of the locations are added to variableSet.
+	void expandRanges(StringSet* variableSet);
+
 	// Saves the log to a file.
 	void saveToFile(FILE* f);
 
 	// Loads from log from a file.
 	bool loadFromFile(FILE* f);
 
+	// Saves and loads the log in the compact encoding (see ActionLogEncoding.h).
+	void saveToEncoder(ActionLogEncoder* encoder);
+	bool loadFromDecoder(ActionLogDecoder* decoder);
+
 	struct Command {
 		CommandType m_cmdType;
 		// Memory location for reads/writes and scope id for scopes. Should be -1 if the location is unused.
@@ -117,6 +134,14 @@ public:
 		return *(it->second);
 	}
 	int maxEventActionId() const { return m_maxEventActionId; }
+	// The currently started event action, -1 if not in an event action.
+	int currentEventActionId() const { return m_currentEventActionId; }
+	// Returns the creation ordinal of a new object in the current event action (or outside of event actions).
+	unsigned nextObjectOrdinal() { return m_objectOrdinals[m_currentEventActionId]++; }
+	bool hasEventAction(int i) const { return m_eventActions.find(i) != m_eventActions.end(); }
+
+	// The number of commands in all event actions.
+	size_t numCommands() const;
 
 private:
 	struct PendingTriggerArc {
@@ -136,6 +161,9 @@ private:
 	// Fields to help construction.
 	int m_currentEventActionId;
 	std::set<Command> m_cmdsInCurrentEvent;
+
+	// Number of objects named in each running event action (and outside of event actions), see ActionLogObjectName.
+	std::map<int, unsigned> m_objectOrdinals;
 };
 
 #endif /* ACTIONLOG_H_ */
@@ -0,0 +1,422 @@
+/*
+ * ActionLogEncoding.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "ActionLogEncoding.h"
+#include "LittleEndianIO.h"
+
+#include <string.h>
+
+namespace {
+
+const char encodedMagic[4] = { 'E', 'R', 'A', 'L' };
+const uint32_t encodedVersion = 1;
+
+const size_t blockSize = 256 * 1024;
+const uint32_t compressedFlag = 0x80000000u;
+
+// Command tags: the low four bits hold the command type, the high four bits the location mode.
+enum LocationMode {
+	LOCATION_NONE = 0,
+	LOCATION_DELTA = 1,
+	LOCATION_RECENT = 2 // LOCATION_RECENT + i is a hit in recent location i
+};
+
+const int numRecentLocations = 8;
+
+// LZ4 block format parameters.
+const int minMatch = 4;
+const size_t lastLiterals = 5;
+const size_t matchFindLimit = 12;
+const int hashLog = 14;
+const size_t maxOffset = 65535;
+
+uint32_t read32(const char* p) {
+	uint32_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+uint32_t hashSequence(uint32_t sequence) {
+	return (sequence * 2654435761u) >> (32 - hashLog);
+}
+
+void writeLength(std::vector<char>* dst, size_t length) {
+	while (length >= 255) {
+		dst->push_back((char)255);
+		length -= 255;
+	}
+	dst->push_back((char)length);
+}
+
+void writeSequence(std::vector<char>* dst, const char* literals, size_t numLiterals, size_t offset, size_t matchLength) {
+	size_t matchCode = matchLength - minMatch;
+	dst->push_back((char)(((numLiterals < 15 ? numLiterals : 15) << 4) | (matchCode < 15 ? matchCode : 15)));
+	if (numLiterals >= 15) {
+		writeLength(dst, numLiterals - 15);
+	}
+	dst->insert(dst->end(), literals, literals + numLiterals);
+	dst->push_back((char)(offset & 0xFF));
+	dst->push_back((char)(offset >> 8));
+	if (matchCode >= 15) {
+		writeLength(dst, matchCode - 15);
+	}
+}
+
+uint32_t zigzag(int32_t value) {
+	return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+int32_t unzigzag(uint32_t value) {
+	return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+}  // namespace
+
+size_t ActionLogCompressBlock(const char* src, size_t size, std::vector<char>* dst) {
+	dst->clear();
+
+	size_t anchor = 0;
+	size_t pos = 0;
+
+	if (size > matchFindLimit) {
+		std::vector<int> table(1 << hashLog, -1);
+		const size_t limit = size - matchFindLimit;
+
+		while (pos < limit) {
+			uint32_t sequence = read32(src + pos);
+			uint32_t h = hashSequence(sequence);
+			int candidate = table[h];
+			table[h] = pos;
+
+			if (candidate < 0 || pos - candidate > maxOffset || read32(src + candidate) != sequence) {
+				++pos;
+				continue;
+			}
+
+			size_t length = minMatch;
+			while (pos + length < size - lastLiterals && src[candidate + length] == src[pos + length]) {
+				++length;
+			}
+
+			writeSequence(dst, src + anchor, pos - anchor, pos - candidate, length);
+			pos += length;
+			anchor = pos;
+		}
+	}
+
+	// Last literals
+	size_t numLiterals = size - anchor;
+	dst->push_back((char)((numLiterals < 15 ? numLiterals : 15) << 4));
+	if (numLiterals >= 15) {
+		writeLength(dst, numLiterals - 15);
+	}
+	dst->insert(dst->end(), src + anchor, src + size);
+
+	return dst->size();
+}
+
+bool ActionLogDecompressBlock(const char* src, size_t size, char* dst, size_t dstSize) {
+	const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+	const unsigned char* inEnd = in + size;
+	size_t out = 0;
+
+	while (in < inEnd) {
+		unsigned token = *in++;
+
+		size_t numLiterals = token >> 4;
+		if (numLiterals == 15) {
+			unsigned char b;
+			do {
+				if (in >= inEnd) return false;
+				b = *in++;
+				numLiterals += b;
+			} while (b == 255);
+		}
+		if ((size_t)(inEnd - in) < numLiterals || dstSize - out < numLiterals) return false;
+		memcpy(dst + out, in, numLiterals);
+		in += numLiterals;
+		out += numLiterals;
+
+		if (in == inEnd) break;  // The last sequence has no match.
+
+		if (inEnd - in < 2) return false;
+		size_t offset = in[0] | (in[1] << 8);
+		in += 2;
+		if (offset == 0 || offset > out) return false;
+
+		size_t matchLength = (token & 0xF);
+		if (matchLength == 15) {
+			unsigned char b;
+			do {
+				if (in >= inEnd) return false;
+				b = *in++;
+				matchLength += b;
+			} while (b == 255);
+		}
+		matchLength += minMatch;
+		if (dstSize - out < matchLength) return false;
+
+		// Matches may overlap with the output, copy byte by byte.
+		for (size_t i = 0; i < matchLength; ++i, ++out) {
+			dst[out] = dst[out - offset];
+		}
+	}
+
+	return out == dstSize;
+}
+
+ActionLogEncoder::ActionLogEncoder(FILE* f)
+	: m_file(f), m_finished(false), m_lastArcTail(0), m_lastEventActionId(0), m_nextRecentLocation(0) {
+	for (int i = 0; i < 16; ++i) m_lastLocation[i] = 0;
+	for (int i = 0; i < numRecentLocations; ++i) m_recentLocations[i] = -1;
+
+	m_block.reserve(blockSize);
+	fwrite(encodedMagic, 1, sizeof(encodedMagic), m_file);
+	writeUInt32(m_file, encodedVersion);
+}
+
+ActionLogEncoder::~ActionLogEncoder() {
+	finish();
+}
+
+void ActionLogEncoder::writeVarint(uint32_t value) {
+	// A varint is at most five bytes, keep blocks within blockSize.
+	if (m_block.size() + 5 > blockSize) {
+		flushBlock();
+	}
+
+	while (value >= 0x80) {
+		m_block.push_back((char)((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	m_block.push_back((char)value);
+}
+
+void ActionLogEncoder::writeSignedVarint(int32_t value) {
+	writeVarint(zigzag(value));
+}
+
+void ActionLogEncoder::writeBytes(const char* data, size_t size) {
+	while (size > 0) {
+		size_t n = blockSize - m_block.size();
+		if (n > size) n = size;
+		m_block.insert(m_block.end(), data, data + n);
+		data += n;
+		size -= n;
+
+		if (m_block.size() >= blockSize) {
+			flushBlock();
+		}
+	}
+}
+
+void ActionLogEncoder::writeArc(const ActionLog::Arc& arc) {
+	writeSignedVarint(arc.m_tail - m_lastArcTail);
+	writeSignedVarint(arc.m_head - arc.m_tail);
+	writeSignedVarint(arc.m_duration);
+	m_lastArcTail = arc.m_tail;
+}
+
+void ActionLogEncoder::writeEventActionHeader(int id, ActionLog::EventActionType type, int numCommands) {
+	writeSignedVarint(id - m_lastEventActionId);
+	writeVarint(type);
+	writeVarint(numCommands);
+	m_lastEventActionId = id;
+}
+
+void ActionLogEncoder::writeCommand(const ActionLog::Command& command) {
+	int type = command.m_cmdType;
+	int location = command.m_location;
+
+	if (location == -1) {
+		writeVarint(type | (LOCATION_NONE << 4));
+		return;
+	}
+
+	for (int i = 0; i < numRecentLocations; ++i) {
+		if (m_recentLocations[i] == location) {
+			writeVarint(type | ((LOCATION_RECENT + i) << 4));
+			m_lastLocation[type] = location;
+			return;
+		}
+	}
+
+	writeVarint(type | (LOCATION_DELTA << 4));
+	writeSignedVarint(location - m_lastLocation[type]);
+	m_lastLocation[type] = location;
+
+	m_recentLocations[m_nextRecentLocation] = location;
+	m_nextRecentLocation = (m_nextRecentLocation + 1) % numRecentLocations;
+}
+
+void ActionLogEncoder::finish() {
+	if (m_finished) return;
+	m_finished = true;
+
+	flushBlock();
+	writeUInt32(m_file, 0);
+	writeUInt32(m_file, 0);
+	fflush(m_file);
+}
+
+void ActionLogEncoder::flushBlock() {
+	if (m_block.empty()) return;
+
+	size_t compressedSize = ActionLogCompressBlock(m_block.data(), m_block.size(), &m_compressed);
+
+	writeUInt32(m_file, m_block.size());
+	if (compressedSize < m_block.size()) {
+		writeUInt32(m_file, compressedSize | compressedFlag);
+		fwrite(m_compressed.data(), 1, compressedSize, m_file);
+	} else {
+		writeUInt32(m_file, m_block.size());
+		fwrite(m_block.data(), 1, m_block.size(), m_file);
+	}
+
+	m_block.clear();
+}
+
+ActionLogDecoder::ActionLogDecoder(FILE* f)
+	: m_file(f), m_position(0), m_ended(false), m_lastArcTail(0), m_lastEventActionId(0), m_nextRecentLocation(0) {
+	for (int i = 0; i < 16; ++i) m_lastLocation[i] = 0;
+	for (int i = 0; i < numRecentLocations; ++i) m_recentLocations[i] = -1;
+}
+
+bool ActionLogDecoder::isEncoded(FILE* f) {
+	char magic[sizeof(encodedMagic)];
+	long position = ftell(f);
+	bool encoded = fread(magic, 1, sizeof(magic), f) == sizeof(magic) && memcmp(magic, encodedMagic, sizeof(magic)) == 0;
+	fseek(f, position, SEEK_SET);
+	return encoded;
+}
+
+bool ActionLogDecoder::readHeader() {
+	char magic[sizeof(encodedMagic)];
+	uint32_t version;
+	if (fread(magic, 1, sizeof(magic), m_file) != sizeof(magic) || memcmp(magic, encodedMagic, sizeof(magic)) != 0) return false;
+	if (!readUInt32(m_file, &version) || version != encodedVersion) return false;
+	return true;
+}
+
+bool ActionLogDecoder::fillBlock() {
+	if (m_ended) return false;
+
+	uint32_t size, storedSize;
+	if (!readUInt32(m_file, &size) || !readUInt32(m_file, &storedSize)) return false;
+
+	if (size == 0) {
+		m_ended = true;
+		return false;
+	}
+	if (size > blockSize) return false;
+
+	bool compressed = storedSize & compressedFlag;
+	storedSize &= ~compressedFlag;
+	if (storedSize > blockSize * 2) return false;
+
+	m_block.resize(size);
+	m_position = 0;
+
+	if (!compressed) {
+		return storedSize == size && fread(m_block.data(), 1, size, m_file) == size;
+	}
+
+	m_compressed.resize(storedSize);
+	if (fread(m_compressed.data(), 1, storedSize, m_file) != storedSize) return false;
+	return ActionLogDecompressBlock(m_compressed.data(), storedSize, m_block.data(), size);
+}
+
+bool ActionLogDecoder::readByte(unsigned char* value) {
+	if (m_position == m_block.size() && !fillBlock()) return false;
+	*value = m_block[m_position++];
+	return true;
+}
+
+bool ActionLogDecoder::readVarint(uint32_t* value) {
+	uint32_t result = 0;
+	for (int shift = 0; shift < 35; shift += 7) {
+		unsigned char b;
+		if (!readByte(&b)) return false;
+		result |= (uint32_t)(b & 0x7F) << shift;
+		if (!(b & 0x80)) {
+			*value = result;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ActionLogDecoder::readSignedVarint(int32_t* value) {
+	uint32_t encoded;
+	if (!readVarint(&encoded)) return false;
+	*value = unzigzag(encoded);
+	return true;
+}
+
+bool ActionLogDecoder::readBytes(char* data, size_t size) {
+	while (size > 0) {
+		if (m_position == m_block.size() && !fillBlock()) return false;
+		size_t n = m_block.size() - m_position;
+		if (n > size) n = size;
+		memcpy(data, m_block.data() + m_position, n);
+		m_position += n;
+		data += n;
+		size -= n;
+	}
+	return true;
+}
+
+bool ActionLogDecoder::readArc(ActionLog::Arc* arc) {
+	int32_t tailDelta, headDelta, duration;
+	if (!readSignedVarint(&tailDelta) || !readSignedVarint(&headDelta) || !readSignedVarint(&duration)) return false;
+	arc->m_tail = m_lastArcTail + tailDelta;
+	arc->m_head = arc->m_tail + headDelta;
+	arc->m_duration = duration;
+	m_lastArcTail = arc->m_tail;
+	return true;
+}
+
+bool ActionLogDecoder::readEventActionHeader(int* id, ActionLog::EventActionType* type, int* numCommands) {
+	int32_t idDelta;
+	uint32_t eventActionType, commands;
+	if (!readSignedVarint(&idDelta) || !readVarint(&eventActionType) || !readVarint(&commands)) return false;
+	*id = m_lastEventActionId + idDelta;
+	*type = static_cast<ActionLog::EventActionType>(eventActionType);
+	*numCommands = commands;
+	m_lastEventActionId = *id;
+	return true;
+}
+
+bool ActionLogDecoder::readCommand(ActionLog::Command* command) {
+	uint32_t tag;
+	if (!readVarint(&tag)) return false;
+
+	int type = tag & 0xF;
+	int mode = tag >> 4;
+	command->m_cmdType = static_cast<ActionLog::CommandType>(type);
+
+	if (mode == LOCATION_NONE) {
+		command->m_location = -1;
+		return true;
+	}
+
+	if (mode >= LOCATION_RECENT) {
+		if (mode - LOCATION_RECENT >= numRecentLocations) return false;
+		command->m_location = m_recentLocations[mode - LOCATION_RECENT];
+		m_lastLocation[type] = command->m_location;
+		return true;
+	}
+
+	int32_t delta;
+	if (!readSignedVarint(&delta)) return false;
+	command->m_location = m_lastLocation[type] + delta;
+	m_lastLocation[type] = command->m_location;
+
+	m_recentLocations[m_nextRecentLocation] = command->m_location;
+	m_nextRecentLocation = (m_nextRecentLocation + 1) % numRecentLocations;
+	return true;
+}
@@ -0,0 +1,105 @@
+/*
+ * ActionLogEncoding.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef ACTIONLOGENCODING_H_
+#define ACTIONLOGENCODING_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+
+#include "ActionLog.h"
+
+// Compact encoding of ER_actionlog.
+//
+// The file starts with the magic "ERAL" and a version, followed by a stream of blocks. Each block holds up
+// to 256KB of encoded data, compressed with LZ4 (block format) if that makes it smaller. A zero sized block
+// ends the stream.
+//
+// The encoded data has the same layout as the raw format (variable set, scope set, action log, js set and
+// data set), but all integers are varints. Event action ids and arcs are delta encoded, and each command is
+// a tag byte holding the command type and how the location is encoded:
+//   - no location (-1),
+//   - a zigzag varint delta against the last location of the same command type, or
+//   - a hit in a small table of recently used locations (no further bytes).
+//
+// Both the encoder and the decoder stream, only one block is kept in memory at a time.
+
+// Compresses src into dst using the LZ4 block format. Returns the compressed size.
+size_t ActionLogCompressBlock(const char* src, size_t size, std::vector<char>* dst);
+// Decompresses an LZ4 block of exactly dstSize bytes. Returns false if the block is malformed.
+bool ActionLogDecompressBlock(const char* src, size_t size, char* dst, size_t dstSize);
+
+class ActionLogEncoder {
+public:
+	// Writes the file header.
+	explicit ActionLogEncoder(FILE* f);
+	~ActionLogEncoder();
+
+	void writeVarint(uint32_t value);
+	void writeSignedVarint(int32_t value);
+	void writeBytes(const char* data, size_t size);
+
+	void writeArc(const ActionLog::Arc& arc);
+	void writeEventActionHeader(int id, ActionLog::EventActionType type, int numCommands);
+	void writeCommand(const ActionLog::Command& command);
+
+	// Flushes the last block and writes the end of stream marker.
+	void finish();
+
+private:
+	void flushBlock();
+
+	FILE* m_file;
+	std::vector<char> m_block;
+	std::vector<char> m_compressed;
+	bool m_finished;
+
+	int m_lastArcTail;
+	int m_lastEventActionId;
+	int m_lastLocation[16];
+	int m_recentLocations[8];
+	int m_nextRecentLocation;
+};
+
+class ActionLogDecoder {
+public:
+	explicit ActionLogDecoder(FILE* f);
+
+	// Returns whether the file at the current position starts with the encoded format header.
+	// The file position is not changed.
+	static bool isEncoded(FILE* f);
+
+	// Reads the file header. Returns false if this is not an encoded action log.
+	bool readHeader();
+
+	bool readVarint(uint32_t* value);
+	bool readSignedVarint(int32_t* value);
+	bool readBytes(char* data, size_t size);
+
+	bool readArc(ActionLog::Arc* arc);
+	bool readEventActionHeader(int* id, ActionLog::EventActionType* type, int* numCommands);
+	bool readCommand(ActionLog::Command* command);
+
+private:
+	bool readByte(unsigned char* value);
+	bool fillBlock();
+
+	FILE* m_file;
+	std::vector<char> m_block;
+	std::vector<char> m_compressed;
+	size_t m_position;
+	bool m_ended;
+
+	int m_lastArcTail;
+	int m_lastEventActionId;
+	int m_lastLocation[16];
+	int m_recentLocations[8];
+	int m_nextRecentLocation;
+};
+
+#endif /* ACTIONLOGENCODING_H_ */
@@ -12,6 +12,11 @@
 #include "ActionLogReport.h"
 #include "WTFThreadData.h"
 #include "StringSet.h"
+#include "ActionLogEncoding.h"
+#include "ActionLogSummary.h"
+#include "HashMap.h"
+#include "Threading.h"
+#include "Vector.h"
 
 #include <set>
 #include <queue>
@@ -36,6 +41,12 @@ bool ActionLogInStrictMode() {
     return strict_mode;
 }
 
+static bool range_commands = false;
+
+void ActionLogRangeCommands(bool enabled) {
+	range_commands = enabled;
+}
+
 void ActionLogScopeStart(const char* name) {
 //	printf("Scope %s\n", name);
 	int scopeId = wtfThreadData().scopeSet()->addString(name);
@@ -94,8 +105,29 @@ void ActionLogReportArrayWrite(size_t array, int index) {
 	ActionLogFormat(ActionLog::WRITE_MEMORY, "Array[%d]$[%d]", static_cast<int>(array), index);
 }
 
-void ActionLogReportArrayReadScan(size_t array, int index) {
-	ActionLogFormat(ActionLog::READ_MEMORY, "Array[%d]$[%d]", static_cast<int>(array), index);
+// With range commands a single command covers the whole range, such that bulk operations log in constant
+// time and space. Otherwise every cell is logged, like the race detector expects.
+void ActionLogReportArrayReadRange(size_t array, int start, int length) {
+	if (length <= 0) return;
+	if (range_commands) {
+		ActionLogFormat(ActionLog::READ_RANGE, "Array[%d]$[%d:%d]", static_cast<int>(array), start, length);
+		return;
+	}
+	for (int index = start; index < start + length; ++index) {
+		ActionLogFormat(ActionLog::READ_MEMORY, "Array[%d]$[%d]", static_cast<int>(array), index);
+	}
+}
+
+void ActionLogReportArrayWriteRange(size_t array, int start, int length) {
+	if (length <= 0) return;
+	ActionLogFormat(ActionLog::READ_MEMORY, "Array[%d]$LEN", static_cast<int>(array));
+	if (range_commands) {
+		ActionLogFormat(ActionLog::WRITE_RANGE, "Array[%d]$[%d:%d]", static_cast<int>(array), start, length);
+		return;
+	}
+	for (int index = start; index < start + length; ++index) {
+		ActionLogFormat(ActionLog::WRITE_MEMORY, "Array[%d]$[%d]", static_cast<int>(array), index);
+	}
 }
 
 void ActionLogReportArrayReadLen(size_t array) {
@@ -116,6 +148,42 @@ void ActionLogReportMemoryValue(const char* value) {
     }
 }
 
+// Strings up to this length (in code units) are reported inline.
+static const unsigned inlineStringValueLength = 64;
+static const unsigned stringValuePrefixLength = 16;
+
+template <typename CharType>
+static void reportStringValue(const CharType* characters, unsigned length) {
+	if (length <= inlineStringValueLength) {
+		ActionLogFormat(ActionLog::MEMORY_VALUE, "\"%s\"", String(characters, length).utf8().data());
+		return;
+	}
+
+	// FNV-1a over the UTF-16 code units, an 8-bit string hashes like its 16-bit copy.
+	uint64_t hash = 14695981039346656037ULL;
+	for (unsigned i = 0; i < length; ++i) {
+		UChar c = characters[i];
+		hash = (hash ^ (c & 0xFF)) * 1099511628211ULL;
+		hash = (hash ^ (c >> 8)) * 1099511628211ULL;
+	}
+
+	// Do not split a surrogate pair.
+	unsigned prefixLength = stringValuePrefixLength;
+	if ((characters[prefixLength - 1] & 0xFC00) == 0xD800)
+		prefixLength--;
+
+	ActionLogFormat(ActionLog::MEMORY_VALUE, "\"%s\"...[%u:%016llx]",
+			String(characters, prefixLength).utf8().data(), length, static_cast<unsigned long long>(hash));
+}
+
+void ActionLogReportStringValue(const LChar* characters, unsigned length) {
+	reportStringValue(characters, length);
+}
+
+void ActionLogReportStringValue(const UChar* characters, unsigned length) {
+	reportStringValue(characters, length);
+}
+
 void ActionLogEnterOperation(int id, ActionLog::EventActionType type) {
     wtfThreadData().actionLog()->startEventAction(id);
     if (!wtfThreadData().actionLog()->setEventActionType(type) && strict_mode) {
@@ -167,24 +235,230 @@ int ActionLogRegisterSource(const char* src) {
 	return wtfThreadData().jsSet()->addString(src);
 }
 
+namespace {
+
+typedef HashMap<const void*, ActionLogObjectId> ObjectIdMap;
+
+// Guards objectIds(), see ActionLogObjectIds.
+Mutex& objectIdsLock() {
+	AtomicallyInitializedStatic(Mutex&, lock = *new Mutex);
+	return lock;
+}
+
+ObjectIdMap& objectIds() {
+	AtomicallyInitializedStatic(ObjectIdMap&, ids = *new ObjectIdMap);
+	return ids;
+}
+
+ActionLogObjectId newObjectId() {
+	WTFThreadData& data = wtfThreadData();
+	ActionLogObjectId id;
+	id.m_eventAction = data.actionLog()->currentEventActionId();
+	id.m_ordinal = data.actionLog()->nextObjectOrdinal();
+	id.m_owner = data.actionLogObjectIds();
+	return id;
+}
+
+}  // namespace
+
+ActionLogObjectIds::~ActionLogObjectIds() {
+	MutexLocker locker(objectIdsLock());
+	ObjectIdMap& ids = objectIds();
+
+	Vector<const void*> owned;
+	for (ObjectIdMap::const_iterator it = ids.begin(); it != ids.end(); ++it) {
+		if (it->second.m_owner == this) {
+			owned.append(it->first);
+		}
+	}
+	for (size_t i = 0; i < owned.size(); ++i) {
+		ids.remove(owned[i]);
+	}
+}
+
+void ActionLogRegisterObject(const void* object) {
+	if (!object) return;
+	ActionLogObjectId id = newObjectId();
+	MutexLocker locker(objectIdsLock());
+	// The pointer may be reused from an object that was never unregistered, it gets a new id.
+	objectIds().set(object, id);
+}
+
+void ActionLogUnregisterObject(const void* object) {
+	if (!object) return;
+	MutexLocker locker(objectIdsLock());
+	objectIds().remove(object);
+}
+
+ActionLogObjectName::ActionLogObjectName(const void* object) {
+	if (!object) {
+		snprintf(m_name, sizeof(m_name), "null");
+		return;
+	}
+
+	MutexLocker locker(objectIdsLock());
+	ObjectIdMap::AddResult result = objectIds().add(object, ActionLogObjectId());
+	if (result.isNewEntry) {
+		result.iterator->second = newObjectId();
+	}
+	snprintf(m_name, sizeof(m_name), "%d.%u", result.iterator->second.m_eventAction, result.iterator->second.m_ordinal);
+}
+
 bool ActionLogWillAddCommand(ActionLog::CommandType cmd) {
 	return wtfThreadData().actionLog()->willLogCommand(cmd);
 }
 
-void ActionLogSave(const std::string& path) {
+bool ActionLogIsActive() {
+	return wtfThreadData().actionLog()->currentEventActionId() != -1;
+}
+
+static void saveActionLog(FILE* f, ActionLogFileFormat format, StringSet* variableSet, StringSet* scopeSet, ActionLog* actionLog, StringSet* jsSet, StringSet* dataSet) {
+	if (format == ActionLogEncoded) {
+		ActionLogEncoder encoder(f);
+		variableSet->saveToEncoder(&encoder);
+		scopeSet->saveToEncoder(&encoder);
+		actionLog->saveToEncoder(&encoder);
+		jsSet->saveToEncoder(&encoder);
+		dataSet->saveToEncoder(&encoder);
+		encoder.finish();
+		return;
+	}
+
+	variableSet->saveToFile(f);
+	scopeSet->saveToFile(f);
+	actionLog->saveToFile(f);
+	jsSet->saveToFile(f);
+	dataSet->saveToFile(f);
+}
+
+static bool loadActionLog(FILE* f, StringSet* variableSet, StringSet* scopeSet, ActionLog* actionLog, StringSet* jsSet, StringSet* dataSet) {
+	if (ActionLogDecoder::isEncoded(f)) {
+		ActionLogDecoder decoder(f);
+		return decoder.readHeader() &&
+				variableSet->loadFromDecoder(&decoder) &&
+				scopeSet->loadFromDecoder(&decoder) &&
+				actionLog->loadFromDecoder(&decoder) &&
+				jsSet->loadFromDecoder(&decoder) &&
+				dataSet->loadFromDecoder(&decoder);
+	}
+
+	return variableSet->loadFromFile(f) &&
+			scopeSet->loadFromFile(f) &&
+			actionLog->loadFromFile(f) &&
+			jsSet->loadFromFile(f) &&
+			dataSet->loadFromFile(f);
+}
+
+void ActionLogSave(const std::string& path, ActionLogFileFormat format) {
     FILE* f = fopen(path.c_str(), "wb");
-	wtfThreadData().variableSet()->saveToFile(f);
-	wtfThreadData().scopeSet()->saveToFile(f);
-	wtfThreadData().actionLog()->saveToFile(f);
-	wtfThreadData().jsSet()->saveToFile(f);
-	wtfThreadData().dataSet()->saveToFile(f);
+	WTFThreadData& data = wtfThreadData();
+	saveActionLog(f, format, data.variableSet(), data.scopeSet(), data.actionLog(), data.jsSet(), data.dataSet());
 	fclose(f);
 }
 
+bool ActionLogConvert(const std::string& inPath, const std::string& outPath, ActionLogFileFormat format) {
+	StringSet variableSet, scopeSet, jsSet, dataSet;
+	ActionLog actionLog;
+
+	FILE* in = fopen(inPath.c_str(), "rb");
+	if (!in) return false;
+	bool loaded = loadActionLog(in, &variableSet, &scopeSet, &actionLog, &jsSet, &dataSet);
+	fclose(in);
+	if (!loaded) return false;
+
+	// The raw format is converted for the race detector, which reads single locations only.
+	if (format == ActionLogRaw) {
+		actionLog.expandRanges(&variableSet);
+	}
+
+	FILE* out = fopen(outPath.c_str(), "wb");
+	if (!out) return false;
+	saveActionLog(out, format, &variableSet, &scopeSet, &actionLog, &jsSet, &dataSet);
+	bool written = !ferror(out);
+	fclose(out);
+	return written;
+}
+
+bool ActionLogDecode(const std::string& path, size_t* numCommands) {
+	StringSet variableSet, scopeSet, jsSet, dataSet;
+	ActionLog actionLog;
+
+	FILE* in = fopen(path.c_str(), "rb");
+	if (!in) return false;
+	bool loaded = loadActionLog(in, &variableSet, &scopeSet, &actionLog, &jsSet, &dataSet);
+	fclose(in);
+
+	*numCommands = actionLog.numCommands();
+	return loaded;
+}
+
+bool ActionLogReadArcs(const std::string& path, std::vector<ActionLog::Arc>* arcs) {
+	StringSet variableSet, scopeSet, jsSet, dataSet;
+	ActionLog actionLog;
+
+	FILE* in = fopen(path.c_str(), "rb");
+	if (!in) return false;
+	bool loaded = loadActionLog(in, &variableSet, &scopeSet, &actionLog, &jsSet, &dataSet);
+	fclose(in);
+	if (!loaded) return false;
+
+	*arcs = actionLog.arcs();
+
+	for (int id = 0; id <= actionLog.maxEventActionId(); ++id) {
+		if (!actionLog.hasEventAction(id)) continue;
+
+		const std::vector<ActionLog::Command>& commands = actionLog.event_action(id).m_commands;
+		for (size_t i = 0; i < commands.size(); ++i) {
+			if (commands[i].m_cmdType == ActionLog::TRIGGER_ARC && commands[i].m_location > id) {
+				ActionLog::Arc arc;
+				arc.m_tail = id;
+				arc.m_head = commands[i].m_location;
+				arc.m_duration = -1;
+				arcs->push_back(arc);
+			}
+		}
+	}
+
+	return true;
+}
+
+static bool saveSummary(const std::string& path, ActionLog* actionLog, StringSet* variableSet, const StringSet& dataSet) {
+	// The summary names single cells, like the raw log read by the race detector.
+	actionLog->expandRanges(variableSet);
+	ActionLogSummary summary(*actionLog, *variableSet, dataSet);
+	return summary.saveToFile(path) && summary.saveToJSONFile(path + ".json");
+}
+
+void ActionLogSaveSummary(const std::string& path) {
+	WTFThreadData& data = wtfThreadData();
+	saveSummary(path, data.actionLog(), data.variableSet(), *data.dataSet());
+}
+
+bool ActionLogSummarize(const std::string& inPath, const std::string& outPath) {
+	StringSet variableSet, scopeSet, jsSet, dataSet;
+	ActionLog actionLog;
+
+	FILE* in = fopen(inPath.c_str(), "rb");
+	if (!in) return false;
+	bool loaded = loadActionLog(in, &variableSet, &scopeSet, &actionLog, &jsSet, &dataSet);
+	fclose(in);
+
+	return loaded && saveSummary(outPath, &actionLog, &variableSet, dataSet);
+}
+
 const std::vector<ActionLog::Arc>& ActionLogReportArcs() {
     return wtfThreadData().actionLog()->arcs();
 }
 
+size_t ActionLogEventActionCommandCount(int id) {
+	return wtfThreadData().actionLog()->event_action(id).m_commands.size();
+}
+
+size_t ActionLogInternedBytes() {
+	WTFThreadData& data = wtfThreadData();
+	return data.variableSet()->dataSize() + data.scopeSet()->dataSize() + data.jsSet()->dataSize() + data.dataSet()->dataSize();
+}
+
 
 EventAttachLog::EventAttachLog() {
 }
@@ -262,42 +536,151 @@ void EventAttachLog::addEventStr(void* eventTarget, const char* str) {
     addEvent(eventTarget, type);
 }
 
+// Attached events are kept in one intrusive doubly linked list per event type. Every entry is also
+// linked into a per-target list, reachable through a hash map, such that all events of a target can be
+// dropped without scanning the queues. Adding, pulling and removing an entry are all O(1).
 class EventAttachLogImpl : public EventAttachLog {
 public:
-	EventAttachLogImpl() {}
-	virtual ~EventAttachLogImpl() {}
+	EventAttachLogImpl()
+		: m_policy(PULL_BY_EVENT_TYPE)
+		, m_nextType(0) {
+		for (int i = 0; i < EV_NUM_EVENTS; ++i) {
+			m_queues[i].first = NULL;
+			m_queues[i].last = NULL;
+		}
+	}
 
-    virtual void removeEventTarget(void* eventTarget) {
+	virtual ~EventAttachLogImpl() {
 		for (int i = 0; i < EV_NUM_EVENTS; ++i) {
-			int l = m_queues[i].size();
-			for (int j = 0; j < l; ++j) {
-				if (m_queues[i].empty()) break;
-				if (m_queues[i].front() != eventTarget) {
-					m_queues[i].push_back(m_queues[i].front());
-				}
-				m_queues[i].pop_front();
+			Entry* entry = m_queues[i].first;
+			while (entry != NULL) {
+				Entry* next = entry->next;
+				delete entry;
+				entry = next;
 			}
 		}
 	}
 
+    virtual void removeEventTarget(void* eventTarget) {
+		TargetMap::iterator it = m_targets.find(eventTarget);
+		if (it == m_targets.end()) {
+			return;
+		}
+
+		Entry* entry = it->second;
+		m_targets.remove(it);
+
+		while (entry != NULL) {
+			Entry* next = entry->nextForTarget;
+			unlinkFromQueue(entry);
+			delete entry;
+			entry = next;
+		}
+	}
+
     virtual void addEvent(void* eventTarget, EventType eventType) {
-		m_queues[eventType].push_back(eventTarget);
+		ASSERT(eventTarget != NULL);
+
+		Entry* entry = new Entry;
+		entry->target = eventTarget;
+		entry->type = eventType;
+
+		Queue& queue = m_queues[eventType];
+		entry->prev = queue.last;
+		entry->next = NULL;
+		if (queue.last != NULL) {
+			queue.last->next = entry;
+		} else {
+			queue.first = entry;
+		}
+		queue.last = entry;
+
+		TargetMap::AddResult result = m_targets.add(eventTarget, entry);
+		entry->prevForTarget = NULL;
+		entry->nextForTarget = result.isNewEntry ? NULL : result.iterator->second;
+		if (entry->nextForTarget != NULL) {
+			entry->nextForTarget->prevForTarget = entry;
+		}
+		result.iterator->second = entry;
 	}
 
     virtual bool pullEvent(void** eventTarget, EventType* eventType) {
-		for (int i = 0; i < EV_NUM_EVENTS; ++i) {
-			if (!m_queues[i].empty()) {
-                *eventType = static_cast<EventType>(i);
-				*eventTarget = m_queues[i].front();
-                m_queues[i].pop_front();
-				return true;
+		int start = m_policy == PULL_ROUND_ROBIN ? m_nextType : 0;
+
+		for (int k = 0; k < EV_NUM_EVENTS; ++k) {
+			int i = (start + k) % EV_NUM_EVENTS;
+			Entry* entry = m_queues[i].first;
+			if (entry == NULL) {
+				continue;
 			}
+
+			*eventType = static_cast<EventType>(i);
+			*eventTarget = entry->target;
+
+			unlinkFromQueue(entry);
+			unlinkFromTarget(entry);
+			delete entry;
+
+			m_nextType = (i + 1) % EV_NUM_EVENTS;
+			return true;
 		}
 		return false;
 	}
 
+    virtual void setPullPolicy(PullPolicy policy) {
+		m_policy = policy;
+		m_nextType = 0;
+	}
+
 private:
-    std::deque<void*> m_queues[EV_NUM_EVENTS];
+	struct Entry {
+		void* target;
+		EventType type;
+		Entry* prev;
+		Entry* next;
+		Entry* prevForTarget;
+		Entry* nextForTarget;
+	};
+
+	struct Queue {
+		Entry* first;
+		Entry* last;
+	};
+
+	typedef WTF::HashMap<void*, Entry*> TargetMap;
+
+	void unlinkFromQueue(Entry* entry) {
+		Queue& queue = m_queues[entry->type];
+		if (entry->prev != NULL) {
+			entry->prev->next = entry->next;
+		} else {
+			queue.first = entry->next;
+		}
+		if (entry->next != NULL) {
+			entry->next->prev = entry->prev;
+		} else {
+			queue.last = entry->prev;
+		}
+	}
+
+	void unlinkFromTarget(Entry* entry) {
+		if (entry->nextForTarget != NULL) {
+			entry->nextForTarget->prevForTarget = entry->prevForTarget;
+		}
+		if (entry->prevForTarget != NULL) {
+			entry->prevForTarget->nextForTarget = entry->nextForTarget;
+		} else if (entry->nextForTarget != NULL) {
+			m_targets.set(entry->target, entry->nextForTarget);
+		} else {
+			m_targets.remove(entry->target);
+		}
+	}
+
+	Queue m_queues[EV_NUM_EVENTS];
+	TargetMap m_targets;
+
+	PullPolicy m_policy;
+	int m_nextType;
 };
 
 EventAttachLog* getEventAttachLog() {
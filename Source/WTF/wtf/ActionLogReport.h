@@ -11,6 +11,7 @@
 #include "ActionLog.h"
 
 #include <wtf/ExportMacros.h>
+#include <wtf/HashMap.h>
 #include <wtf/text/WTFString.h>
 
 class ActionLogScope {
@@ -22,19 +23,31 @@ public:
 void ActionLogStrictMode(bool strict);
 bool ActionLogInStrictMode();
 
+// Logs bulk array accesses as a single READ_RANGE or WRITE_RANGE command instead of one command per cell. Off by
+// default, the race detector does not read range commands (convert the log to the raw format first).
+void ActionLogRangeCommands(bool enabled);
+
 void ActionLogScopeStart(const char* name);
 void ActionLogScopeEnd();
 
 void ActionLogReportMemoryValue(const char* value);
+// Reports a string value. Short strings are reported inline ("value"), longer strings by a prefix, their length
+// and a 64-bit hash of their UTF-16 code units ("prefix"...[length:hash]), such that equal strings get equal values.
+void ActionLogReportStringValue(const LChar* characters, unsigned length);
+void ActionLogReportStringValue(const UChar* characters, unsigned length);
 
 void ActionLogReportArrayRead(size_t array, int index);  // Reads from a single array index.
 void ActionLogReportArrayWrite(size_t array, int index);  // Write to a single array index.
-void ActionLogReportArrayReadScan(size_t array, int index);  // Reads a cell by scanning it.
+void ActionLogReportArrayReadRange(size_t array, int start, int length);  // Reads length cells from start by scanning them.
+void ActionLogReportArrayWriteRange(size_t array, int start, int length);  // Writes length cells from start, keeps the length.
 void ActionLogReportArrayReadLen(size_t array);  // Reads the array length.
-void ActionLogReportArrayModify(size_t array);  // Writes to more than one array element or resizes an array.
+void ActionLogReportArrayModify(size_t array);  // Rewrites or resizes the whole array, logged as a write of its length.
 
 void ActionLogFormat(ActionLog::CommandType cmd, const char* format, ...);
 bool ActionLogWillAddCommand(ActionLog::CommandType cmd);
+// Whether commands are logged at all (i.e. an event action is running). Cheap enough to test before
+// computing the location and value of a command.
+bool ActionLogIsActive();
 
 void ActionLogEnterOperation(int id, ActionLog::EventActionType type);
 void ActionLogExitOperation();
@@ -42,10 +55,38 @@ void ActionLogExitOperation();
 int ActionLogScopeDepth();
 
 void ActionLogAddArc(int earlierId, int laterId, int duration);
-void ActionLogSave(const std::string& path);
+// Formats of ER_actionlog. The raw format is read by the race detector, the encoded format is
+// a compact varint, delta and LZ4 encoded format, see ActionLogEncoding.h. Both keep range commands (see
+// ActionLogRangeCommands()).
+enum ActionLogFileFormat {
+	ActionLogRaw,
+	ActionLogEncoded
+};
+
+void ActionLogSave(const std::string& path, ActionLogFileFormat format = ActionLogRaw);
+
+// Converts an ER_actionlog file in either format to the given format. Range commands are expanded to one
+// command per location when converting to the raw format.
+bool ActionLogConvert(const std::string& inPath, const std::string& outPath, ActionLogFileFormat format);
+// Reads an ER_actionlog file in either format, returning the number of commands read (for benchmarking).
+bool ActionLogDecode(const std::string& path, size_t* numCommands);
+
+// Reads the happens-before arcs of an ER_actionlog file in either format. Besides the explicit arcs, an
+// event action triggering another one (TRIGGER_ARC) is returned as an arc with unknown duration.
+bool ActionLogReadArcs(const std::string& path, std::vector<ActionLog::Arc>* arcs);
+
+// Writes a summary of the memory accesses of the current log (see ActionLogSummary.h) to path and path.json.
+void ActionLogSaveSummary(const std::string& path);
+// Writes the summary of an ER_actionlog file in either format to outPath and outPath.json.
+bool ActionLogSummarize(const std::string& inPath, const std::string& outPath);
 
 const std::vector<ActionLog::Arc>& ActionLogReportArcs();
 
+// The number of commands logged for an event action.
+size_t ActionLogEventActionCommandCount(int id);
+// The number of bytes interned in the variable, scope, js and data string sets.
+size_t ActionLogInternedBytes();
+
 // Logs that an event identified by a pointer eventId is triggered node.
 void ActionLogTriggerEvent(void* eventId);
 // Logs that the id of the currently entered operation is the one triggered by a
@@ -54,6 +95,41 @@ void ActionLogEventTriggered(void* eventId);
 
 int ActionLogRegisterSource(const char* src);
 
+// Logical object ids used in location and value names instead of pointers, which differ between runs.
+// An object is named "<event action>.<ordinal>" after the event action creating it and its creation order
+// within that event action, so the same object gets the same name in a replay of the same schedule.
+//
+// Objects are registered when created and unregistered when destroyed. An object that was never registered
+// is assigned an id the first time it is named, its class must still unregister it when destroyed (as
+// EventTarget and EventListener do) or a later object at the same address would inherit its name.
+void ActionLogRegisterObject(const void* object);
+void ActionLogUnregisterObject(const void* object);
+
+class ActionLogObjectName {
+public:
+	explicit ActionLogObjectName(const void* object);
+
+	const char* data() const { return m_name; }
+
+private:
+	char m_name[32];
+};
+
+struct ActionLogObjectIds;
+
+struct ActionLogObjectId {
+	int m_eventAction;
+	unsigned m_ordinal;
+	ActionLogObjectIds* m_owner;  // The thread that named the object.
+};
+
+// The ids of the live objects of all threads are kept in one map, as an object may be destroyed (and unregistered)
+// on another thread than the one that named it. Each thread owns an ActionLogObjectIds in its WTFThreadData, which
+// drops the ids the thread left behind when it exits.
+struct ActionLogObjectIds {
+	~ActionLogObjectIds();
+};
+
 class EventAttachLog {
 public:
 	EventAttachLog();
@@ -80,11 +156,19 @@ public:
 	static const char* EventTypeStr(EventType t);
     static EventAttachLog::EventType StrEventType(const char* t);
 
+	// Order in which pullEvent picks attached events.
+	enum PullPolicy {
+		PULL_BY_EVENT_TYPE = 0, // Exhaust event types in EventType order (keydown before keyup, ...).
+		PULL_ROUND_ROBIN        // Rotate across event types, one event of each type at a time.
+	};
+
     void addEventStr(void* eventTarget, const char* str);
 
     virtual void removeEventTarget(void* eventTarget) = 0;
     virtual void addEvent(void* eventTarget, EventType eventType) = 0;
     virtual bool pullEvent(void** eventTarget, EventType* eventType) = 0;
+
+    virtual void setPullPolicy(PullPolicy policy) = 0;
 };
 
 EventAttachLog* getEventAttachLog();
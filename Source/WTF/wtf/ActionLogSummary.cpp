@@ -0,0 +1,214 @@
+/*
+ * ActionLogSummary.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "ActionLogSummary.h"
+#include "LittleEndianIO.h"
+#include "StringSet.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+const char summaryMagic[4] = { 'E', 'R', 'M', 'S' };
+const uint32_t summaryVersion = 1;
+const uint32_t noValue = 0xFFFFFFFF;
+
+void writeString(FILE* f, const char* value) {
+	if (!value) {
+		writeUInt32(f, noValue);
+		return;
+	}
+	size_t length = strlen(value);
+	writeUInt32(f, length);
+	fwrite(value, 1, length, f);
+}
+
+void writeJSONString(FILE* f, const char* value) {
+	fputc('"', f);
+	for (const unsigned char* c = reinterpret_cast<const unsigned char*>(value); *c; ++c) {
+		switch (*c) {
+		case '"': fputs("\\\"", f); break;
+		case '\\': fputs("\\\\", f); break;
+		case '\n': fputs("\\n", f); break;
+		case '\r': fputs("\\r", f); break;
+		case '\t': fputs("\\t", f); break;
+		default:
+			if (*c < 0x20) {
+				fprintf(f, "\\u%04x", *c);
+			} else {
+				fputc(*c, f);
+			}
+		}
+	}
+	fputc('"', f);
+}
+
+}  // namespace
+
+ActionLogSummary::ActionLogSummary(const ActionLog& log, const StringSet& variables, const StringSet& values)
+	: m_variables(variables), m_values(values) {
+	for (int id = 0; id <= log.maxEventActionId(); ++id) {
+		if (!log.hasEventAction(id)) continue;
+
+		const ActionLog::EventAction& eventAction = log.event_action(id);
+
+		EventActionDigest digest;
+		digest.m_id = id;
+		digest.m_type = eventAction.m_type;
+
+		std::map<int, size_t> writtenIndex;
+		int lastAccessed = -1;
+		bool lastAccessWasFirstWrite = false;
+
+		for (size_t i = 0; i < eventAction.m_commands.size(); ++i) {
+			const ActionLog::Command& command = eventAction.m_commands[i];
+
+			switch (command.m_cmdType) {
+			// Ranges are expanded before summarizing (see ActionLog::expandRanges()).
+			case ActionLog::READ_MEMORY:
+				m_locations[command.m_location].m_reads++;
+				digest.m_reads++;
+				lastAccessed = command.m_location;
+				lastAccessWasFirstWrite = false;
+				break;
+
+			case ActionLog::WRITE_MEMORY: {
+				Location& location = m_locations[command.m_location];
+				location.m_writes++;
+				location.m_lastWriter = id;
+				digest.m_writes++;
+
+				// The digest keeps the first value written, later writes to the same location are only counted.
+				lastAccessWasFirstWrite = writtenIndex.find(command.m_location) == writtenIndex.end();
+				if (lastAccessWasFirstWrite) {
+					writtenIndex[command.m_location] = digest.m_written.size();
+					digest.m_written.push_back(std::make_pair(command.m_location, -1));
+				}
+
+				lastAccessed = command.m_location;
+				break;
+			}
+
+			case ActionLog::MEMORY_VALUE:
+				// Values always follow the read or write they belong to.
+				if (lastAccessed != -1) {
+					m_locations[lastAccessed].m_lastValue = command.m_location;
+					if (lastAccessWasFirstWrite) {
+						digest.m_written[writtenIndex[lastAccessed]].second = command.m_location;
+					}
+				}
+				lastAccessed = -1;
+				break;
+
+			case ActionLog::TRIGGER_ARC:
+				if (command.m_location != -1) {
+					digest.m_triggered.push_back(command.m_location);
+				}
+				lastAccessed = -1;
+				break;
+
+			default:
+				lastAccessed = -1;
+				break;
+			}
+		}
+
+		m_eventActions.push_back(digest);
+	}
+}
+
+bool ActionLogSummary::saveToFile(const std::string& path) const {
+	FILE* f = fopen(path.c_str(), "wb");
+	if (!f) return false;
+
+	fwrite(summaryMagic, 1, sizeof(summaryMagic), f);
+	writeUInt32(f, summaryVersion);
+
+	// Event action digests refer to locations by their position in the location table.
+	std::map<int, uint32_t> ordinals;
+	uint32_t ordinal = 0;
+
+	writeUInt32(f, m_locations.size());
+	for (std::map<int, Location>::const_iterator it = m_locations.begin(); it != m_locations.end(); ++it) {
+		ordinals[it->first] = ordinal++;
+		writeString(f, m_variables.getString(it->first));
+		writeUInt32(f, it->second.m_lastWriter);
+		writeString(f, it->second.m_lastValue == -1 ? 0 : m_values.getString(it->second.m_lastValue));
+		writeUInt32(f, it->second.m_reads);
+		writeUInt32(f, it->second.m_writes);
+	}
+
+	writeUInt32(f, m_eventActions.size());
+	for (std::vector<EventActionDigest>::const_iterator it = m_eventActions.begin(); it != m_eventActions.end(); ++it) {
+		writeUInt32(f, it->m_id);
+		writeUInt32(f, it->m_type);
+		writeUInt32(f, it->m_reads);
+		writeUInt32(f, it->m_writes);
+
+		writeUInt32(f, it->m_written.size());
+		for (size_t i = 0; i < it->m_written.size(); ++i) {
+			writeUInt32(f, ordinals[it->m_written[i].first]);
+			writeString(f, it->m_written[i].second == -1 ? 0 : m_values.getString(it->m_written[i].second));
+		}
+
+		writeUInt32(f, it->m_triggered.size());
+		for (size_t i = 0; i < it->m_triggered.size(); ++i) {
+			writeUInt32(f, it->m_triggered[i]);
+		}
+	}
+
+	bool ok = !ferror(f);
+	fclose(f);
+	return ok;
+}
+
+bool ActionLogSummary::saveToJSONFile(const std::string& path) const {
+	FILE* f = fopen(path.c_str(), "w");
+	if (!f) return false;
+
+	fputs("{\n\"locations\": {", f);
+	for (std::map<int, Location>::const_iterator it = m_locations.begin(); it != m_locations.end(); ++it) {
+		fputs(it == m_locations.begin() ? "\n" : ",\n", f);
+		writeJSONString(f, m_variables.getString(it->first));
+		fprintf(f, ": {\"last_writer\": %d, \"value\": ", it->second.m_lastWriter);
+		if (it->second.m_lastValue == -1) {
+			fputs("null", f);
+		} else {
+			writeJSONString(f, m_values.getString(it->second.m_lastValue));
+		}
+		fprintf(f, ", \"reads\": %u, \"writes\": %u}", it->second.m_reads, it->second.m_writes);
+	}
+
+	fputs("\n},\n\"event_actions\": {", f);
+	for (std::vector<EventActionDigest>::const_iterator it = m_eventActions.begin(); it != m_eventActions.end(); ++it) {
+		fputs(it == m_eventActions.begin() ? "\n" : ",\n", f);
+		fprintf(f, "\"%d\": {\"type\": \"%s\", \"reads\": %u, \"writes\": %u, \"written\": {",
+				it->m_id, ActionLog::EventActionType_AsString(it->m_type), it->m_reads, it->m_writes);
+		for (size_t i = 0; i < it->m_written.size(); ++i) {
+			if (i > 0) fputs(", ", f);
+			writeJSONString(f, m_variables.getString(it->m_written[i].first));
+			fputs(": ", f);
+			if (it->m_written[i].second == -1) {
+				fputs("null", f);
+			} else {
+				writeJSONString(f, m_values.getString(it->m_written[i].second));
+			}
+		}
+		fputs("}, \"triggered\": [", f);
+		for (size_t i = 0; i < it->m_triggered.size(); ++i) {
+			fprintf(f, i > 0 ? ", %d" : "%d", it->m_triggered[i]);
+		}
+		fputs("]}", f);
+	}
+	fputs("\n}\n}\n", f);
+
+	bool ok = !ferror(f);
+	fclose(f);
+	return ok;
+}
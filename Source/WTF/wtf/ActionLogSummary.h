@@ -0,0 +1,67 @@
+/*
+ * ActionLogSummary.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef ACTIONLOGSUMMARY_H_
+#define ACTIONLOGSUMMARY_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ActionLog.h"
+
+class StringSet;
+
+// Summary of the memory accesses in an action log, written next to ER_actionlog such that batch reports
+// do not have to query the race analyzer for the memory state.
+//
+// The summary contains, for each memory location, the last event action writing it and the value logged
+// with its last recorded access, and for each event action a digest of its accesses (the value written to
+// each location and the event actions it triggered).
+//
+// ActionLog records only the first access of each kind to a location within an event action (see
+// m_cmdsInCurrentEvent), so the values in a digest are the first ones written by that event action, not
+// the values it left behind.
+//
+// It is written as a binary file (magic "ERMS") and as JSON.
+class ActionLogSummary {
+public:
+	ActionLogSummary(const ActionLog& log, const StringSet& variables, const StringSet& values);
+
+	bool saveToFile(const std::string& path) const;
+	bool saveToJSONFile(const std::string& path) const;
+
+private:
+	struct Location {
+		Location() : m_lastWriter(-1), m_lastValue(-1), m_reads(0), m_writes(0) {}
+
+		int m_lastWriter;
+		int m_lastValue;  // Index in the value set of the value logged with the last recorded access, -1 if none.
+		unsigned m_reads;
+		unsigned m_writes;
+	};
+
+	struct EventActionDigest {
+		EventActionDigest() : m_id(-1), m_type(ActionLog::UNKNOWN), m_reads(0), m_writes(0) {}
+
+		int m_id;
+		ActionLog::EventActionType m_type;
+		unsigned m_reads;
+		unsigned m_writes;
+		// Written location -> first value written (-1 if no value was logged), in order of first write.
+		std::vector<std::pair<int, int> > m_written;
+		std::vector<int> m_triggered;
+	};
+
+	const StringSet& m_variables;
+	const StringSet& m_values;
+
+	std::map<int, Location> m_locations;  // Keyed on the index in the variable set.
+	std::vector<EventActionDigest> m_eventActions;
+};
+
+#endif /* ACTIONLOGSUMMARY_H_ */
@@ -49,29 +49,131 @@ EventActionSchedule* EventActionSchedule::deserialize(std::istream& stream)
         std::string eventaction;
         std::getline(stream, eventaction);
 
-        if (eventaction.compare("") == 0) {
-            continue; // ignore blank lines
+        EventActionScheduleItem item;
+        if (deserializeItem(eventaction, &item)) {
+            schedule->append(item);
         }
+    }
+
+    return schedule;
+}
+
+bool EventActionSchedule::deserializeItem(const std::string& eventaction, EventActionScheduleItem* item)
+{
+    if (eventaction.compare("") == 0) {
+        return false; // ignore blank lines
+    }
+
+    if (eventaction.compare("<relax>") == 0 || eventaction.compare("<change>") == 0) {
+        *item = EventActionScheduleItem(0, WTF::EventActionDescriptor::null);
+        return true;
+    }
+
+    std::stringstream eventactionStream(eventaction);
+
+    std::string id;
+    std::getline(eventactionStream, id, ';');
+
+    std::string description;
+    std::getline(eventactionStream, description);
+
+    *item = EventActionScheduleItem(atoi(id.c_str()), WTF::EventActionDescriptor::deserialize(description));
+    return true;
+}
+
+EventActionScheduleWriter::EventActionScheduleWriter()
+    : m_file(tmpfile())
+    , m_size(0)
+{
+}
+
+EventActionScheduleWriter::~EventActionScheduleWriter()
+{
+    if (m_file) {
+        fclose(m_file);
+    }
+}
+
+bool EventActionScheduleWriter::setPath(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "w+");
+    if (!file) {
+        return false;
+    }
+
+    if (m_file) {
+        fflush(m_file);
+        rewind(m_file);
 
-        if (eventaction.compare("<relax>") == 0 || eventaction.compare("<change>") == 0) {
-            schedule->append(std::pair<WTF::EventActionId, WTF::EventActionDescriptor>(0, WTF::EventActionDescriptor::null));
-            continue;
+        char buffer[4096];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), m_file)) > 0) {
+            fwrite(buffer, 1, read, file);
         }
 
-        std::stringstream eventactionStream(eventaction);
+        fclose(m_file);
+    }
 
-        std::string id;
-        std::getline(eventactionStream, id, ';');
+    fflush(file);
 
-        std::string description;
-        std::getline(eventactionStream, description);
+    m_file = file;
+    m_path = path;
+    return true;
+}
 
-        WTF::EventActionDescriptor descriptor = WTF::EventActionDescriptor::deserialize(description);
+void EventActionScheduleWriter::append(const EventActionScheduleItem& item)
+{
+    ++m_size;
 
-        schedule->append(std::pair<WTF::EventActionId, WTF::EventActionDescriptor>(atoi(id.c_str()), descriptor));
+    if (!m_file) {
+        return;
     }
 
-    return schedule;
+    std::string line = item.second.serialize();
+    fprintf(m_file, "%d;%s\n", item.first, line.c_str());
+
+    // Flush after every event action, such that the schedule is complete if the process crashes.
+    fflush(m_file);
+}
+
+void EventActionScheduleWriter::serialize(std::ostream& stream)
+{
+    if (!m_file) {
+        return;
+    }
+
+    fflush(m_file);
+    rewind(m_file);
+
+    char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), m_file)) > 0) {
+        stream.write(buffer, read);
+    }
+
+    fseek(m_file, 0, SEEK_END);
+}
+
+EventActionScheduleReader::EventActionScheduleReader(const std::string& path)
+    : m_stream(path.c_str())
+    , m_hasNext(false)
+{
+    advance();
+}
+
+void EventActionScheduleReader::advance()
+{
+    m_hasNext = false;
+
+    while (m_stream.good()) {
+        std::string eventaction;
+        std::getline(m_stream, eventaction);
+
+        if (EventActionSchedule::deserializeItem(eventaction, &m_next)) {
+            m_hasNext = true;
+            return;
+        }
+    }
 }
 
 }
@@ -27,7 +27,9 @@
 #include <string>
 #include <ostream>
 #include <istream>
+#include <fstream>
 #include <utility>
+#include <stdio.h>
 
 #include <wtf/Noncopyable.h>
 #include <wtf/ExportMacros.h>
@@ -47,6 +49,53 @@ namespace WebCore {
 
         void serialize(std::ostream& stream) const;
         static EventActionSchedule* deserialize(std::istream& stream);
+
+        // Parses one line of a schedule. Returns false for blank lines.
+        static bool deserializeItem(const std::string& line, EventActionScheduleItem* item);
+    };
+
+    // Appends event actions to a schedule on disk as they are dispatched, such that the schedule does not grow
+    // in memory and survives a crash. Items are written to an anonymous temporary file, or to a given path.
+    class EventActionScheduleWriter {
+        WTF_MAKE_NONCOPYABLE(EventActionScheduleWriter);
+
+    public:
+        EventActionScheduleWriter();
+        ~EventActionScheduleWriter();
+
+        // Writes to path from now on, including the items written so far. Returns false if path can't be opened.
+        bool setPath(const std::string& path);
+        const std::string& path() const { return m_path; }
+
+        void append(const EventActionScheduleItem& item);
+        size_t size() const { return m_size; }
+
+        // Writes all items appended so far in the schedule format.
+        void serialize(std::ostream& stream);
+
+    private:
+        FILE* m_file;
+        std::string m_path;
+        size_t m_size;
+    };
+
+    // Forward cursor over a schedule file, reading one item ahead.
+    class EventActionScheduleReader {
+        WTF_MAKE_NONCOPYABLE(EventActionScheduleReader);
+
+    public:
+        explicit EventActionScheduleReader(const std::string& path);
+
+        bool isEmpty() const { return !m_hasNext; }
+
+        // The next item of the schedule, only valid if the schedule is not empty.
+        const EventActionScheduleItem& next() const { return m_next; }
+        void advance();
+
+    private:
+        std::ifstream m_stream;
+        EventActionScheduleItem m_next;
+        bool m_hasNext;
     };
 }
 
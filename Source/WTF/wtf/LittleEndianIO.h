@@ -0,0 +1,77 @@
+/*
+ * LittleEndianIO.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef LITTLEENDIANIO_H_
+#define LITTLEENDIANIO_H_
+
+#include <istream>
+#include <ostream>
+#include <stdint.h>
+#include <stdio.h>
+
+// Little endian integer I/O shared by the binary WebERA logs (ER_actionlog, errors.log, summaries and
+// profiles), such that they read the same on every host.
+
+namespace WTF {
+
+inline void encodeUInt32(uint32_t value, unsigned char bytes[4])
+{
+    for (int i = 0; i < 4; ++i) {
+        bytes[i] = (value >> (8 * i)) & 0xFF;
+    }
+}
+
+inline uint32_t decodeUInt32(const unsigned char bytes[4])
+{
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+inline void writeUInt32(FILE* f, uint32_t value)
+{
+    unsigned char bytes[4];
+    encodeUInt32(value, bytes);
+    fwrite(bytes, 1, 4, f);
+}
+
+inline bool readUInt32(FILE* f, uint32_t* value)
+{
+    unsigned char bytes[4];
+    if (fread(bytes, 1, 4, f) != 4) {
+        return false;
+    }
+    *value = decodeUInt32(bytes);
+    return true;
+}
+
+inline void writeUInt32(std::ostream& out, uint32_t value)
+{
+    unsigned char bytes[4];
+    encodeUInt32(value, bytes);
+    out.write(reinterpret_cast<const char*>(bytes), 4);
+}
+
+inline void writeUInt64(std::ostream& out, uint64_t value)
+{
+    writeUInt32(out, (uint32_t)(value & 0xFFFFFFFF));
+    writeUInt32(out, (uint32_t)(value >> 32));
+}
+
+// Returns 0 for the missing bytes of a truncated stream, callers check the stream state.
+inline uint32_t readUInt32(std::istream& in)
+{
+    unsigned char bytes[4] = { 0, 0, 0, 0 };
+    in.read(reinterpret_cast<char*>(bytes), 4);
+    return decodeUInt32(bytes);
+}
+
+} // namespace WTF
+
+using WTF::readUInt32;
+using WTF::writeUInt32;
+using WTF::writeUInt64;
+
+#endif /* LITTLEENDIANIO_H_ */
@@ -0,0 +1,59 @@
+/*
+ * SequenceRegistry.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "config.h"
+#include "SequenceRegistry.h"
+
+#include <string.h>
+
+namespace WTF {
+
+std::string SequenceRegistry::Key::serialize() const
+{
+    std::string serialized;
+    for (size_t i = 0; i < m_numParts; ++i)
+        serialized.append(bytes(m_parts[i]), m_parts[i].m_size);
+    return serialized;
+}
+
+bool SequenceRegistry::Key::equals(const std::string& serialized) const
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < m_numParts; ++i) {
+        const Part& part = m_parts[i];
+        if (serialized.size() - offset < part.m_size || memcmp(serialized.data() + offset, bytes(part), part.m_size))
+            return false;
+        offset += part.m_size;
+    }
+    return offset == serialized.size();
+}
+
+unsigned SequenceRegistry::next(const Key& key)
+{
+    HashMap<uint64_t, Entry>::AddResult result = m_sequences.add(key.hash(), Entry());
+    Entry& entry = result.iterator->second;
+
+    if (result.isNewEntry) {
+        entry.m_key = key.serialize();
+        entry.m_next = 1;
+        return 0;
+    }
+
+    if (key.equals(entry.m_key))
+        return entry.m_next++;
+
+    // The hash collides with a different key.
+    return m_collisions[key.serialize()]++;
+}
+
+void SequenceRegistry::reset()
+{
+    m_sequences.clear();
+    m_collisions.clear();
+}
+
+} // namespace WTF
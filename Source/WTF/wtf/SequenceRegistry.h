@@ -0,0 +1,132 @@
+/*
+ * SequenceRegistry.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SequenceRegistry_h
+#define SequenceRegistry_h
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <wtf/HashMap.h>
+#include <wtf/Assertions.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/unicode/Unicode.h>
+
+namespace WTF {
+
+// WebERA: Hands out sequence numbers (0, 1, 2, ...) per key, used to tell apart event actions with the same
+// name, e.g. timers installed at the same line in the same event action or requests of the same URL.
+//
+// A key is a tuple of strings and integers. It is built on the stack and hashed (64-bit FNV-1a) while it is
+// built, without copying the strings, such that looking up a known key does not allocate. On a hit the key
+// is compared in place against the stored copy, keys with colliding hashes are counted in a separate (slow)
+// map.
+class SequenceRegistry {
+    WTF_MAKE_NONCOPYABLE(SequenceRegistry);
+public:
+    class Key {
+    public:
+        Key()
+            : m_hash(14695981039346656037ULL)
+            , m_numParts(0)
+        {
+        }
+
+        // Strings are prefixed by their length, ("ab", "c") and ("a", "bc") are different keys. The characters
+        // are not copied, they must stay alive until the key is looked up.
+        Key& add(const char* characters, size_t length)
+        {
+            add(static_cast<int64_t>(length));
+            return addBytes(characters, length);
+        }
+
+        Key& add(const UChar* characters, size_t length)
+        {
+            add(static_cast<int64_t>(length));
+            return addBytes(reinterpret_cast<const char*>(characters), length * sizeof(UChar));
+        }
+
+        Key& add(int64_t value)
+        {
+            Part& part = nextPart();
+            part.m_data = 0;
+            part.m_size = sizeof(value);
+            part.m_value = value;
+            hashBytes(bytes(part), part.m_size);
+            return *this;
+        }
+
+        // 0 and -1 are the empty and deleted values of the hash table.
+        uint64_t hash() const { return (m_hash == 0 || m_hash == static_cast<uint64_t>(-1)) ? 1 : m_hash; }
+
+        // The key as one string, stored for new keys.
+        std::string serialize() const;
+        // Whether serialized is serialize() of this key, without building it.
+        bool equals(const std::string& serialized) const;
+
+    private:
+        struct Part {
+            const char* m_data; // 0 for integers, which are kept in m_value
+            size_t m_size;
+            int64_t m_value;
+        };
+
+        // A string takes two parts (its length and its characters).
+        static const size_t maxParts = 8;
+
+        static const char* bytes(const Part& part) { return part.m_data ? part.m_data : reinterpret_cast<const char*>(&part.m_value); }
+
+        Part& nextPart()
+        {
+            ASSERT(m_numParts < maxParts);
+            return m_parts[m_numParts++];
+        }
+
+        Key& addBytes(const char* data, size_t size)
+        {
+            Part& part = nextPart();
+            part.m_data = data ? data : "";
+            part.m_size = size;
+            part.m_value = 0;
+            hashBytes(data, size);
+            return *this;
+        }
+
+        void hashBytes(const char* data, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+                m_hash = (m_hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+        }
+
+        uint64_t m_hash;
+        Part m_parts[maxParts];
+        size_t m_numParts;
+    };
+
+    SequenceRegistry() { }
+
+    // Returns the next sequence number of key, starting at 0.
+    WTF_EXPORT_PRIVATE unsigned next(const Key&);
+
+    // Forgets all keys, e.g. when a new page is loaded.
+    WTF_EXPORT_PRIVATE void reset();
+
+private:
+    struct Entry {
+        std::string m_key;
+        unsigned m_next;
+    };
+
+    HashMap<uint64_t, Entry> m_sequences;
+    std::map<std::string, unsigned> m_collisions;
+};
+
+} // namespace WTF
+
+using WTF::SequenceRegistry;
+
+#endif // SequenceRegistry_h
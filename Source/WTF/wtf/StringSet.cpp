@@ -6,6 +6,7 @@
  */
 
 #include "StringSet.h"
+#include "ActionLogEncoding.h"
 #include <string.h>
 #include <string>
 #include <tr1/functional_hash.h>
@@ -109,3 +110,20 @@ bool StringSet::loadFromFile(FILE* f) {
 	return true;
 }
 
+
+void StringSet::saveToEncoder(ActionLogEncoder* encoder) {
+	encoder->writeVarint(m_data.size());
+	encoder->writeBytes(m_data.data(), m_data.size());
+	encoder->writeVarint(m_hashes.size());
+}
+
+bool StringSet::loadFromDecoder(ActionLogDecoder* decoder) {
+	uint32_t n = 0;
+	if (!decoder->readVarint(&n)) return false;
+	m_data.resize(n, 0);
+	if (!decoder->readBytes(m_data.data(), n)) return false;
+	if (!decoder->readVarint(&n)) return false;
+	m_hashes.assign(n, -1);
+	rehashAll();
+	return true;
+}
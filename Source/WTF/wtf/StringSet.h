@@ -11,6 +11,9 @@
 #include <stdio.h>
 #include <vector>
 
+class ActionLogEncoder;
+class ActionLogDecoder;
+
 class StringSet {
 public:
 	StringSet();
@@ -34,6 +37,13 @@ public:
 	// Loads the string set from a file.
 	bool loadFromFile(FILE* f);
 
+	// Saves and loads the string set in the compact encoding (see ActionLogEncoding.h).
+	void saveToEncoder(ActionLogEncoder* encoder);
+	bool loadFromDecoder(ActionLogDecoder* decoder);
+
+	// The number of bytes used by the interned strings.
+	size_t dataSize() const { return m_data.size(); }
+
 private:
 	// Returns the index of the added string.
 	int addStringL(const char* s, int slen);
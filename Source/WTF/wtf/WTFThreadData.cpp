@@ -28,6 +28,7 @@
 #include "WTFThreadData.h"
 
 #include "ActionLog.h"
+#include "ActionLogReport.h"
 #include "warningcollector.h"
 #include "StringSet.h"
 
@@ -47,6 +48,7 @@ WTFThreadData::WTFThreadData()
     , m_jsSet(new StringSet())
     , m_dataSet(new StringSet())
     , m_actionLog(new ActionLog())
+    , m_actionLogObjectIds(new ActionLogObjectIds())
     , m_eventAttachLog(NULL)
     , m_warningCollector(new WTF::WarningCollector())
 #endif
@@ -64,6 +66,7 @@ WTFThreadData::~WTFThreadData()
     delete m_jsSet;
     delete m_dataSet;
     delete m_actionLog;
+    delete m_actionLogObjectIds;
     if (m_eventAttachLog != NULL) {
         delete m_eventAttachLog;
     }
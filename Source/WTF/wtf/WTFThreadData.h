@@ -70,6 +70,7 @@ private:
 
 class StringSet;
 class ActionLog;
+struct ActionLogObjectIds;
 class EventAttachLog;
 #endif
 
@@ -137,6 +138,10 @@ public:
     	return m_actionLog;
     }
 
+    ActionLogObjectIds* actionLogObjectIds() {
+    	return m_actionLogObjectIds;
+    }
+
     EventAttachLog* eventAttachLog() {
     	return m_eventAttachLog;
     }
@@ -163,6 +168,7 @@ private:
     StringSet* m_jsSet;
     StringSet* m_dataSet;
     ActionLog* m_actionLog;
+    ActionLogObjectIds* m_actionLogObjectIds;
     EventAttachLog* m_eventAttachLog;
     WarningCollector* m_warningCollector;
 #endif
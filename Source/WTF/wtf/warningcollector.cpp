@@ -22,41 +22,165 @@
  */
 
 #include "warningcollector.h"
+#include "LittleEndianIO.h"
 
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
+#include <cstring>
 #include <assert.h>
-#include <malloc.h>
 #include <sstream>
+#include <stdint.h>
 
 namespace WTF {
 
+// Binary errors.log: magic, version, string table, categories (with counters) and warnings.
+// All integers are 32 bit little endian.
+static const char binaryMagic[4] = { 'E', 'R', 'W', 'L' };
+static const uint32_t binaryVersion = 1;
+
+WarningCollector::WarningCollector()
+    : m_rateLimit(DefaultRateLimit)
+{
+}
+
+unsigned int WarningCollector::intern(const std::string& str)
+{
+    std::map<std::string, unsigned int>::iterator iter = m_stringIds.find(str);
+    if (iter != m_stringIds.end()) {
+        return iter->second;
+    }
+
+    unsigned int id = m_strings.size();
+    m_strings.push_back(str);
+    m_stringIds.insert(std::make_pair(str, id));
+    return id;
+}
+
+unsigned int WarningCollector::category(const std::string& module, const std::string& shortDescription)
+{
+    std::pair<unsigned int, unsigned int> key(intern(module), intern(shortDescription));
+
+    std::map<std::pair<unsigned int, unsigned int>, unsigned int>::iterator iter = m_categoryIds.find(key);
+    if (iter != m_categoryIds.end()) {
+        return iter->second;
+    }
+
+    unsigned int id = m_categories.size();
+    m_categories.push_back(Category(key.first, key.second));
+    m_categoryIds.insert(std::make_pair(key, id));
+    return id;
+}
+
+bool WarningCollector::detailsAllowed(unsigned int category) const
+{
+    return m_rateLimit == 0 || m_categories[category].count <= m_rateLimit;
+}
+
 void WarningCollector::collect(EventActionId eventActionId, const std::string& module, const std::string& shortDescription, const std::string& details)
 {
-    m_warnings.push_back(Warning(eventActionId, module, shortDescription, details));
+    unsigned int id = category(module, shortDescription);
+    m_categories[id].count++;
+
+    unsigned int detailsId = NoDetails;
+    if (details.length() != 0 && detailsAllowed(id)) {
+        detailsId = intern(details);
+    }
+
+    m_warnings.push_back(Warning(eventActionId, id, detailsId));
 }
 
-void WarningCollector::writeLogFile(const std::string& filepath)
+void WarningCollector::collect(EventActionId eventActionId, const std::string& module, const std::string& shortDescription, WarningDetailsFunction details, void* context)
+{
+    unsigned int id = category(module, shortDescription);
+    m_categories[id].count++;
+
+    unsigned int detailsId = NoDetails;
+    if (details != 0 && detailsAllowed(id)) {
+        // Only render the details if they are going to be stored
+
+        std::stringstream rendered;
+        details(rendered, context);
+
+        if (rendered.str().length() != 0) {
+            detailsId = intern(rendered.str());
+        }
+    }
+
+    m_warnings.push_back(Warning(eventActionId, id, detailsId));
+}
+
+unsigned int WarningCollector::count(const std::string& module, const std::string& shortDescription) const
+{
+    std::map<std::string, unsigned int>::const_iterator moduleIter = m_stringIds.find(module);
+    std::map<std::string, unsigned int>::const_iterator descriptionIter = m_stringIds.find(shortDescription);
+
+    if (moduleIter == m_stringIds.end() || descriptionIter == m_stringIds.end()) {
+        return 0;
+    }
+
+    std::map<std::pair<unsigned int, unsigned int>, unsigned int>::const_iterator iter =
+            m_categoryIds.find(std::make_pair(moduleIter->second, descriptionIter->second));
+
+    return iter == m_categoryIds.end() ? 0 : m_categories[iter->second].count;
+}
+
+void WarningCollector::writeLogFile(const std::string& filepath, WarningLogFormat format)
 {
     std::ofstream fp;
-    fp.open(filepath.c_str(), std::ios_base::out);
+    fp.open(filepath.c_str(), std::ios_base::out | std::ios_base::binary);
 
     assert(fp.is_open());
 
-    std::list<Warning>::iterator iter;
+    if (format == WarningLogBinary) {
+        writeBinaryLogFile(fp);
+    } else {
+        writeTextLogFile(fp);
+    }
+
+    fp.close();
+}
+
+void WarningCollector::writeTextLogFile(std::ostream& fp)
+{
+    std::vector<Warning>::iterator iter;
     for (iter = m_warnings.begin(); iter != m_warnings.end(); iter++) {
 
-        std::string details = ((*iter).details);
+        const Category& category = m_categories[(*iter).category];
+        size_t length = (*iter).details == NoDetails ? 0 : m_strings[(*iter).details].length();
 
-        fp << (int)(*iter).eventActionId << ";" << (*iter).module << ";" << (*iter).shortDescription << ";" << (details.length() == 0 ? 0 : details.length() + 1) << std::endl;
+        fp << (int)(*iter).eventActionId << ";" << m_strings[category.module] << ";" << m_strings[category.shortDescription] << ";" << (length == 0 ? 0 : length + 1) << std::endl;
 
-        if (details.length() != 0) {
-            fp << details << std::endl;
+        if (length != 0) {
+            fp << m_strings[(*iter).details] << std::endl;
         }
     }
+}
 
-    fp.close();
+void WarningCollector::writeBinaryLogFile(std::ostream& fp)
+{
+    fp.write(binaryMagic, sizeof(binaryMagic));
+    writeUInt32(fp, binaryVersion);
+
+    writeUInt32(fp, m_strings.size());
+    for (std::vector<std::string>::iterator iter = m_strings.begin(); iter != m_strings.end(); iter++) {
+        writeUInt32(fp, (*iter).length());
+        fp.write((*iter).data(), (*iter).length());
+    }
+
+    writeUInt32(fp, m_categories.size());
+    for (std::vector<Category>::iterator iter = m_categories.begin(); iter != m_categories.end(); iter++) {
+        writeUInt32(fp, (*iter).module);
+        writeUInt32(fp, (*iter).shortDescription);
+        writeUInt32(fp, (*iter).count);
+    }
+
+    writeUInt32(fp, m_warnings.size());
+    for (std::vector<Warning>::iterator iter = m_warnings.begin(); iter != m_warnings.end(); iter++) {
+        writeUInt32(fp, (*iter).eventActionId);
+        writeUInt32(fp, (*iter).category);
+        writeUInt32(fp, (*iter).details);
+    }
 }
 
 WarningCollector WarningCollector::readLogFile(const std::string& filepath)
@@ -64,10 +188,31 @@ WarningCollector WarningCollector::readLogFile(const std::string& filepath)
     WarningCollector collector;
 
     std::ifstream fp;
-    fp.open(filepath.c_str(), std::ios_base::in);
+    fp.open(filepath.c_str(), std::ios_base::in | std::ios_base::binary);
 
     assert(fp.is_open());
 
+    char magic[sizeof(binaryMagic)];
+    fp.read(magic, sizeof(magic));
+
+    if (fp.gcount() == sizeof(magic) && memcmp(magic, binaryMagic, sizeof(magic)) == 0) {
+        if (!readBinaryLogFile(fp, &collector)) {
+            std::cerr << "Warning: Corrupt warning log " << filepath << ", ignoring it." << std::endl;
+            collector = WarningCollector();
+        }
+    } else {
+        fp.clear();
+        fp.seekg(0);
+        readTextLogFile(fp, &collector);
+    }
+
+    fp.close();
+
+    return collector;
+}
+
+void WarningCollector::readTextLogFile(std::istream& fp, WarningCollector* collector)
+{
     while (fp.good()) {
 
         // Read the entire line and check for the blank line (indicating EOF)
@@ -96,26 +241,73 @@ WarningCollector WarningCollector::readLogFile(const std::string& filepath)
         std::getline(warning, detailsLength);
 
         // If we have details on the next line, then include those
+        // The length includes the trailing newline
 
         int length = atoi(detailsLength.c_str());
 
         if (length == 0) {
-            collector.m_warnings.push_back(Warning((EventActionId)atoi(eventActionId.c_str()), module, shortDescription, ""));
+            collector->collect((EventActionId)atoi(eventActionId.c_str()), module, shortDescription, "");
 
         } else {
-            char* details = new char [length];
-            fp.read(details, length);
+            std::vector<char> details(length);
+            fp.read(&details[0], length);
 
-            collector.m_warnings.push_back(Warning((EventActionId)atoi(eventActionId.c_str()), module, shortDescription, details));
+            collector->collect((EventActionId)atoi(eventActionId.c_str()), module, shortDescription, std::string(&details[0], fp.gcount() > 0 ? fp.gcount() - 1 : 0));
+        }
+
+    }
+}
+
+bool WarningCollector::readBinaryLogFile(std::istream& fp, WarningCollector* collector)
+{
+    uint32_t version = readUInt32(fp);
+    if (version != binaryVersion) {
+        return false;
+    }
+
+    uint32_t numStrings = readUInt32(fp);
+    for (uint32_t i = 0; i < numStrings && fp.good(); ++i) {
+        uint32_t length = readUInt32(fp);
 
-            delete details;
+        std::string str(length, '\0');
+        if (length != 0) {
+            fp.read(&str[0], length);
         }
 
+        collector->m_strings.push_back(str);
+        collector->m_stringIds.insert(std::make_pair(str, i));
     }
 
-    fp.close();
+    uint32_t numCategories = readUInt32(fp);
+    for (uint32_t i = 0; i < numCategories && fp.good(); ++i) {
+        uint32_t module = readUInt32(fp);
+        uint32_t shortDescription = readUInt32(fp);
 
-    return collector;
+        if (module >= collector->m_strings.size() || shortDescription >= collector->m_strings.size()) {
+            return false;
+        }
+
+        Category category(module, shortDescription);
+        category.count = readUInt32(fp);
+
+        collector->m_categories.push_back(category);
+        collector->m_categoryIds.insert(std::make_pair(std::make_pair(category.module, category.shortDescription), i));
+    }
+
+    uint32_t numWarnings = readUInt32(fp);
+    for (uint32_t i = 0; i < numWarnings && fp.good(); ++i) {
+        EventActionId eventActionId = (EventActionId)readUInt32(fp);
+        uint32_t category = readUInt32(fp);
+        uint32_t details = readUInt32(fp);
+
+        if (category >= collector->m_categories.size() || (details != NoDetails && details >= collector->m_strings.size())) {
+            return false;
+        }
+
+        collector->m_warnings.push_back(Warning(eventActionId, category, details));
+    }
+
+    return fp.good();
 }
 
 }
@@ -26,37 +26,89 @@
 
 #include "warningcollectorreport.h"
 
-#include <list>
+#include <map>
+#include <vector>
 #include <wtf/EventActionDescriptor.h>
 
 namespace WTF {
 
+/**
+ * Collects warnings emitted during a record or replay run.
+ *
+ * Modules, short descriptions and details are interned, such that repeated warnings (e.g. the same
+ * timer dump emitted on every skip) are only stored once. Each (module, short description) pair is a
+ * category with its own counter. Details can be limited to the first N warnings of a category (see
+ * setRateLimit()), the dropped details are then missing from the log and thus from the comparisons of
+ * report.py.
+ */
 class WarningCollector
 {
 public:
-    WarningCollector() {}
+    WarningCollector();
+
     void collect(EventActionId eventActionId, const std::string& module, const std::string& shortDescription, const std::string& details);
-    void writeLogFile(const std::string& filepath);
+    void collect(EventActionId eventActionId, const std::string& module, const std::string& shortDescription, WarningDetailsFunction details, void* context);
+
+    // Maximum number of warnings per category stored with details, 0 is unlimited
+    static const unsigned int DefaultRateLimit = 0;
+    void setRateLimit(unsigned int limit) { m_rateLimit = limit; }
+
+    // Number of warnings collected for a category
+    unsigned int count(const std::string& module, const std::string& shortDescription) const;
 
+    void writeLogFile(const std::string& filepath, WarningLogFormat format = WarningLogText);
+
+    // Reads both the text and the binary log format
     static WarningCollector readLogFile(const std::string& filepath);
 
 private:
+    static const unsigned int NoDetails = 0xFFFFFFFF;
+
     typedef struct warning_t {
-        const EventActionId eventActionId;
-        const std::string module;
-        const std::string shortDescription;
-        const std::string details;
+        EventActionId eventActionId;
+        unsigned int category;
+        unsigned int details;
 
-        warning_t(EventActionId eventActionId, const std::string& module, const std::string& shortDescription, const std::string& details)
+        warning_t(EventActionId eventActionId, unsigned int category, unsigned int details)
             : eventActionId(eventActionId)
-            , module(module)
-            , shortDescription(shortDescription)
+            , category(category)
             , details(details)
         {}
 
     } Warning;
 
-    std::list<Warning> m_warnings;
+    typedef struct category_t {
+        unsigned int module;
+        unsigned int shortDescription;
+        unsigned int count;
+
+        category_t(unsigned int module, unsigned int shortDescription)
+            : module(module)
+            , shortDescription(shortDescription)
+            , count(0)
+        {}
+
+    } Category;
+
+    unsigned int intern(const std::string& str);
+    unsigned int category(const std::string& module, const std::string& shortDescription);
+    bool detailsAllowed(unsigned int category) const;
+
+    void writeTextLogFile(std::ostream& fp);
+    void writeBinaryLogFile(std::ostream& fp);
+
+    static void readTextLogFile(std::istream& fp, WarningCollector* collector);
+    static bool readBinaryLogFile(std::istream& fp, WarningCollector* collector);
+
+    std::vector<std::string> m_strings;
+    std::map<std::string, unsigned int> m_stringIds;
+
+    std::vector<Category> m_categories;
+    std::map<std::pair<unsigned int, unsigned int>, unsigned int> m_categoryIds;
+
+    std::vector<Warning> m_warnings;
+
+    unsigned int m_rateLimit;
 };
 
 }
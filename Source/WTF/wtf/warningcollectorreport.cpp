@@ -36,9 +36,14 @@ void WarningCollectorReport(const std::string& module, const std::string& shortD
     wtfThreadData().warningCollector()->collect(currentEventAction, module, shortDescription, details);
 }
 
-void WarningCollecterWriteToLogFile(const std::string& filePath)
+void WarningCollectorReport(const std::string& module, const std::string& shortDescription, WarningDetailsFunction details, void* context)
 {
-    wtfThreadData().warningCollector()->writeLogFile(filePath);
+    wtfThreadData().warningCollector()->collect(currentEventAction, module, shortDescription, details, context);
+}
+
+void WarningCollecterWriteToLogFile(const std::string& filePath, WarningLogFormat format)
+{
+    wtfThreadData().warningCollector()->writeLogFile(filePath, format);
 }
 
 void WarningCollectorSetCurrentEventAction(EventActionId eventActionId)
@@ -46,8 +51,9 @@ void WarningCollectorSetCurrentEventAction(EventActionId eventActionId)
     currentEventAction = eventActionId;
 }
 
+void WarningCollectorSetRateLimit(unsigned int limit)
+{
+    wtfThreadData().warningCollector()->setRateLimit(limit);
 }
 
-
-
-
+}
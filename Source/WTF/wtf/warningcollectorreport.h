@@ -24,14 +24,25 @@
 #ifndef WARNINGCOLLECTORREPORT_H
 #define WARNINGCOLLECTORREPORT_H
 
+#include <ostream>
 #include <string>
 #include <wtf/EventActionDescriptor.h>
 
 namespace WTF {
 
+enum WarningLogFormat {
+    WarningLogText,
+    WarningLogBinary
+};
+
+// Renders the details of a warning, only invoked (synchronously) if the details are stored
+typedef void (*WarningDetailsFunction)(std::ostream& out, void* context);
+
 void WarningCollectorReport(const std::string& module, const std::string& shortDescription, const std::string& details);
-void WarningCollecterWriteToLogFile(const std::string& filePath);
+void WarningCollectorReport(const std::string& module, const std::string& shortDescription, WarningDetailsFunction details, void* context);
+void WarningCollecterWriteToLogFile(const std::string& filePath, WarningLogFormat format = WarningLogText);
 void WarningCollectorSetCurrentEventAction(EventActionId eventActionId);
+void WarningCollectorSetRateLimit(unsigned int limit);
 }
 
 #endif // WARNINGCOLLECTORREPORT_H
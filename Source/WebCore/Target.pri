@@ -75,8 +75,10 @@ SOURCES += \
     bindings/generic/RuntimeEnabledFeatures.cpp \
     platform/schedule/Scheduler.cpp \
     platform/schedule/EventActionRegister.cpp \
+    platform/schedule/EventActionProfiler.cpp \
     dom/EventSender.cpp \
-    platform/network/qt/HBQNetworkHelper.cpp
+    platform/network/qt/HBQNetworkHelper.cpp \
+    platform/network/qt/QNetworkReplySnapshotBody.cpp
 
 v8 {
     include($$PWD/../JavaScriptCore/yarr/yarr.pri)
@@ -1352,6 +1354,7 @@ SOURCES += \
     storage/StorageMap.cpp \
     storage/StorageNamespace.cpp \
     storage/StorageNamespaceImpl.cpp \
+    storage/StorageSnapshot.cpp \
     storage/StorageSyncManager.cpp \
     storage/StorageTracker.cpp \
     testing/Internals.cpp \
@@ -1411,7 +1414,9 @@ HEADERS += \
     bindings/generic/ActiveDOMCallback.h \
     bindings/generic/RuntimeEnabledFeatures.h \
     platform/schedule/EventActionRegister.h \
-    platform/network/qt/HBQNetworkHelper.h
+    platform/schedule/EventActionProfiler.h \
+    platform/network/qt/HBQNetworkHelper.h \
+    platform/network/qt/QNetworkReplySnapshotBody.h
 
 v8 {
     HEADERS += \
@@ -2604,6 +2609,7 @@ HEADERS += \
     storage/StorageMap.h \
     storage/StorageNamespace.h \
     storage/StorageNamespaceImpl.h \
+    storage/StorageSnapshot.h \
     storage/StorageSyncManager.h \
     storage/StorageTask.h \
     storage/StorageThread.h \
@@ -34,7 +34,10 @@
 #include "Page.h"
 #include "SecurityOrigin.h"
 #include "Settings.h"
+#include "ThreadGlobalData.h"
+#include "ThreadTimers.h"
 #include "WebCoreJSClientData.h"
+#include <runtime/JSLock.h>
 #include <wtf/MainThread.h>
 
 #include "Interpreter.h"
@@ -68,6 +71,12 @@ void* convertWindowShellToJSWindow(void* ptr) {
 	return ptr;
 }
 
+// WebERA: Sweep the JS heap in the time left between event actions.
+void sweepJSHeapWhenIdle(double deadline) {
+	JSLock lock(SilenceAssertionsOnly);
+	JSDOMWindowBase::commonJSGlobalData()->heap.sweepIncrementally(deadline);
+}
+
 }  // namespace
 
 JSDOMWindowBase::JSDOMWindowBase(JSGlobalData& globalData, Structure* structure, PassRefPtr<DOMWindow> window, JSDOMWindowShell* shell)
@@ -232,6 +241,10 @@ JSGlobalData* JSDOMWindowBase::commonJSGlobalData()
         globalData->exclusiveThread = currentThread();
 #endif
         initNormalWorldClientData(globalData);
+
+        // WebERA: Keep the sweep out of the collection pauses, these land in the middle of event actions
+        globalData->heap.setIncrementalSweeping(true);
+        threadGlobalData().threadTimers().setIdleCallback(sweepJSHeapWhenIdle);
     }
 
     return globalData;
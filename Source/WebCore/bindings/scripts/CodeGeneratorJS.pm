@@ -1323,6 +1323,7 @@ sub GenerateImplementation
     AddIncludesForSVGAnimatedType($interfaceName) if $className =~ /^JSSVGAnimated/;
 
     $implIncludes{"<wtf/GetPtr.h>"} = 1;
+    $implIncludes{"<wtf/ActionLogReport.h>"} = 1 if $interfaceName eq "Node";
     $implIncludes{"<runtime/PropertyNameArray.h>"} = 1 if $dataNode->extendedAttributes->{"IndexedGetter"} || $dataNode->extendedAttributes->{"NumericIndexedGetter"};
 
     AddIncludesForTypeInImpl($interfaceName);
@@ -1617,6 +1618,11 @@ sub GenerateImplementation
         push(@implContent, "${className}::~${className}()\n");
         push(@implContent, "{\n");
         push(@implContent, "    releaseImplIfNotNull();\n");
+        if ($interfaceName eq "Node") {
+            # WebERA: The action log names node wrappers by a logical id (see JSCellFieldAccess), which a later
+            # wrapper at the same address must not inherit.
+            push(@implContent, "    ActionLogUnregisterObject(this);\n");
+        }
         push(@implContent, "}\n\n");
     }
 
@@ -80,6 +80,9 @@ unsigned CharacterData::parserAppendData(const UChar* data, unsigned dataLength,
 
     m_data.append(data, end);
 
+    if (inDocument())
+        document()->contentHashNodeChanged(this);
+
     updateRenderer(oldLength, 0);
     document()->incDOMTreeVersion();
     // We don't call dispatchModifiedEvent here because we don't want the
@@ -178,6 +181,8 @@ void CharacterData::setDataAndUpdate(const String& newData, unsigned offsetOfRep
         document()->frame()->selection()->textWillBeReplaced(this, offsetOfReplacedData, oldLength, newLength);
     String oldData = m_data;
     m_data = newData;
+    if (inDocument())
+        document()->contentHashNodeChanged(this);
     updateRenderer(offsetOfReplacedData, oldLength);
     document()->incDOMTreeVersion();
     dispatchModifiedEvent(oldData);
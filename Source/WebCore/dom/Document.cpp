@@ -144,8 +144,10 @@
 #include "ShadowRoot.h"
 #include "ShadowTree.h"
 #include "StaticHashSetNodeList.h"
+#include "StylePropertySet.h"
 #include "StyleResolver.h"
 #include "StyleSheetList.h"
+#include "StyledElement.h"
 #include "TextResourceDecoder.h"
 #include "Timer.h"
 #include "ThreadTimers.h"
@@ -493,6 +495,7 @@ Document::Document(Frame* frame, const KURL& url, bool isXHTML, bool isHTML)
 #endif
     , m_lastPendingTasksEventAction(0)
     , m_lastPendingStylesheetEventAction(0)
+    , m_contentHash(0)
 {
     m_document = this;
 
@@ -5238,6 +5241,220 @@ void Document::suspendScheduledTasks(ActiveDOMObject::ReasonForSuspension reason
 
 unsigned int Document::m_seqNumber = 0;
 
+// WebERA: Content hash
+
+bool Document::s_contentHashEnabled = false;
+
+static inline uint64_t contentHashFinalize(uint64_t key)
+{
+    // 64 bit finalizer from MurmurHash3, spreads the input over all bits
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb53fe1a85ec5ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+static inline uint64_t contentHashMix(unsigned high, unsigned low)
+{
+    return contentHashFinalize((static_cast<uint64_t>(high) << 32) | low);
+}
+
+static inline unsigned contentHashOfString(StringImpl* string)
+{
+    return string ? string->hash() : 0;
+}
+
+static inline uint64_t contentHashOfAttribute(const QualifiedName& name, const AtomicString& value)
+{
+    // The style attribute is synchronized lazily from the inline style declaration without any
+    // attribute change notification, the inline style is hashed instead (see contentHashOfNode).
+    if (value.isNull() || name == HTMLNames::styleAttr)
+        return 0;
+
+    return contentHashMix(contentHashOfString(name.localName().impl()), contentHashOfString(value.impl()));
+}
+
+static uint64_t contentHashOfNode(Node* node)
+{
+    if (node->isElementNode()) {
+        Element* element = toElement(node);
+        uint64_t hash = contentHashMix(Node::ELEMENT_NODE, contentHashOfString(element->tagQName().localName().impl()));
+
+        // Read the attribute data directly, updatedAttributeData() could synchronize (and modify) attributes
+        if (ElementAttributeData* attributeData = element->attributeData()) {
+            for (unsigned i = 0; i < attributeData->length(); ++i) {
+                Attribute* attribute = attributeData->attributeItem(i);
+                hash += contentHashOfAttribute(attribute->name(), attribute->value());
+            }
+        }
+
+        if (element->isStyledElement()) {
+            if (const StylePropertySet* inlineStyle = static_cast<StyledElement*>(element)->inlineStyle())
+                hash += contentHashMix(contentHashOfString(HTMLNames::styleAttr.localName().impl()), contentHashOfString(inlineStyle->asText().impl()));
+        }
+
+        return hash;
+    }
+
+    if (node->isCharacterDataNode())
+        return contentHashMix(node->nodeType(), contentHashOfString(node->nodeValue().impl()));
+
+    return contentHashMix(node->nodeType(), 0);
+}
+
+static inline uint64_t contentHashOfEntry(const Document::ContentHashEntry& entry)
+{
+    return contentHashFinalize(entry.m_position ^ contentHashFinalize(entry.m_content));
+}
+
+uint64_t Document::contentHashPositionOf(Node* node, unsigned index) const
+{
+    uint64_t parentPosition = 0;
+
+    if (Node* parent = node->parentNode()) {
+        ContentHashMap::const_iterator it = m_contentHashNodes.find(parent);
+        if (it != m_contentHashNodes.end())
+            parentPosition = it->second.m_position;
+    }
+
+    return contentHashFinalize(parentPosition + (static_cast<uint64_t>(index) + 1) * 0x9e3779b97f4a7c15ULL);
+}
+
+unsigned Document::contentHashIndexOf(Node* node) const
+{
+    Node* previous = node->previousSibling();
+    if (!previous)
+        return 0;
+
+    ContentHashMap::const_iterator it = m_contentHashNodes.find(previous);
+    if (it != m_contentHashNodes.end())
+        return it->second.m_index + 1;
+
+    return node->nodeIndex();
+}
+
+void Document::contentHashReindexSiblings(Node* first, unsigned index)
+{
+    // Siblings following an inserted or removed node changed their index, which changes the position
+    // of their entire subtree.
+    for (Node* child = first; child; child = child->nextSibling(), ++index) {
+        ContentHashMap::iterator it = m_contentHashNodes.find(child);
+        if (it == m_contentHashNodes.end())
+            continue; // not yet notified, the notification will index it
+
+        if (it->second.m_index != index) {
+            it->second.m_index = index;
+
+            for (Node* moved = child; moved; moved = moved->traverseNextNode(child)) {
+                ContentHashMap::iterator movedIt = m_contentHashNodes.find(moved);
+                if (movedIt == m_contentHashNodes.end())
+                    continue;
+
+                m_contentHash -= contentHashOfEntry(movedIt->second);
+                movedIt->second.m_position = contentHashPositionOf(moved, movedIt->second.m_index);
+                m_contentHash += contentHashOfEntry(movedIt->second);
+            }
+        }
+    }
+}
+
+uint64_t Document::contentHash()
+{
+    if (!m_contentHashMovedChildren.isEmpty()) {
+        // Each parent is reindexed once, however many of its children were inserted or removed since the
+        // last read. A parent and its ancestor can be reindexed in any order: a node is repositioned from the
+        // current position of its parent.
+        HashSet<Node*> parents;
+        parents.swap(m_contentHashMovedChildren);
+
+        HashSet<Node*>::iterator end = parents.end();
+        for (HashSet<Node*>::iterator it = parents.begin(); it != end; ++it)
+            contentHashReindexSiblings((*it)->firstChild(), 0);
+    }
+
+    return m_contentHash;
+}
+
+void Document::contentHashNodeInserted(Node* node)
+{
+    if (!s_contentHashEnabled)
+        return;
+
+    ContentHashEntry entry;
+    entry.m_index = contentHashIndexOf(node);
+    entry.m_position = contentHashPositionOf(node, entry.m_index);
+    entry.m_content = contentHashOfNode(node);
+
+    ContentHashMap::AddResult result = m_contentHashNodes.add(node, entry);
+    if (!result.isNewEntry) {
+        m_contentHash -= contentHashOfEntry(result.iterator->second);
+        result.iterator->second = entry;
+    }
+    m_contentHash += contentHashOfEntry(entry);
+
+    // Following siblings not notified yet are inserted together with this node, and indexed when notified.
+    // Siblings notified already move, appending (the common case while parsing) doesn't move anything.
+    Node* next = node->nextSibling();
+    if (next && m_contentHashNodes.contains(next))
+        m_contentHashMovedChildren.add(node->parentNode());
+}
+
+void Document::contentHashNodeRemoved(Node* node, Node* insertionPoint)
+{
+    if (!s_contentHashEnabled)
+        return;
+
+    ContentHashMap::iterator it = m_contentHashNodes.find(node);
+    if (it == m_contentHashNodes.end())
+        return;
+
+    unsigned index = it->second.m_index;
+    m_contentHash -= contentHashOfEntry(it->second);
+    m_contentHashNodes.remove(it);
+    m_contentHashMovedChildren.remove(node);
+
+    // Descendants are notified with the same insertion point while still attached to their parent,
+    // only the root of the removed subtree moves its former siblings (unless it was the last one).
+    if (!node->parentNode()) {
+        Node* last = insertionPoint->lastChild();
+        ContentHashMap::iterator lastIt = last ? m_contentHashNodes.find(last) : m_contentHashNodes.end();
+        if (last && (lastIt == m_contentHashNodes.end() || lastIt->second.m_index >= index))
+            m_contentHashMovedChildren.add(insertionPoint);
+    }
+}
+
+void Document::contentHashNodeChanged(Node* node)
+{
+    if (!s_contentHashEnabled)
+        return;
+
+    ContentHashMap::iterator it = m_contentHashNodes.find(node);
+    if (it == m_contentHashNodes.end())
+        return;
+
+    m_contentHash -= contentHashOfEntry(it->second);
+    it->second.m_content = contentHashOfNode(node);
+    m_contentHash += contentHashOfEntry(it->second);
+}
+
+void Document::contentHashAttributeChanged(Element* element, const QualifiedName& name, const AtomicString& oldValue, const AtomicString& newValue)
+{
+    if (!s_contentHashEnabled)
+        return;
+
+    // Called before the attribute is modified, thus the element can't be rehashed from its attributes
+    ContentHashMap::iterator it = m_contentHashNodes.find(element);
+    if (it == m_contentHashNodes.end())
+        return;
+
+    m_contentHash -= contentHashOfEntry(it->second);
+    it->second.m_content -= contentHashOfAttribute(name, oldValue);
+    it->second.m_content += contentHashOfAttribute(name, newValue);
+    m_contentHash += contentHashOfEntry(it->second);
+}
+
 void Document::resumeScheduledTasks()
 {
 
@@ -942,6 +942,29 @@ public:
     void incDOMTreeVersion() { m_domTreeVersion = ++s_globalTreeVersion; }
     uint64_t domTreeVersion() const { return m_domTreeVersion; }
 
+    // WebERA: Rolling hash of the DOM content of this document.
+    // The hash is a sum of per-node contributions, each mixing the node content (tag name, attributes,
+    // inline style, character data) with its position (the path of child indices from the root).
+    // It is maintained incrementally as nodes are inserted into and removed from the document, and as
+    // attributes, inline style and character data of nodes in the document change. Inserting or removing
+    // a node before its last sibling only marks the parent, the positions of its children are updated
+    // when the hash is read.
+    // The hash is only maintained if enabled before the document is created, it is 0 otherwise.
+    struct ContentHashEntry {
+        uint64_t m_position;
+        uint64_t m_content;
+        unsigned m_index;
+    };
+
+    static void setContentHashEnabled(bool enabled) { s_contentHashEnabled = enabled; }
+    static bool contentHashEnabled() { return s_contentHashEnabled; }
+
+    uint64_t contentHash();
+    void contentHashNodeInserted(Node*);
+    void contentHashNodeRemoved(Node*, Node* insertionPoint);
+    void contentHashNodeChanged(Node*);
+    void contentHashAttributeChanged(Element*, const QualifiedName&, const AtomicString& oldValue, const AtomicString& newValue);
+
     void setDocType(PassRefPtr<DocumentType>);
 
     // XPathEvaluator methods
@@ -1520,6 +1543,18 @@ private:
     MultiJoinHappensBefore m_addedPendingTaskJoin;
     WTF::EventActionId m_lastPendingTasksEventAction;
     WTF::EventActionId m_lastPendingStylesheetEventAction;
+
+    uint64_t contentHashPositionOf(Node*, unsigned index) const;
+    unsigned contentHashIndexOf(Node*) const;
+    void contentHashReindexSiblings(Node* first, unsigned index);
+
+    static bool s_contentHashEnabled;
+
+    typedef HashMap<Node*, ContentHashEntry> ContentHashMap;
+    ContentHashMap m_contentHashNodes;
+    // Nodes whose children may have moved since their positions were computed
+    HashSet<Node*> m_contentHashMovedChildren;
+    uint64_t m_contentHash;
 };
 
 // Put these methods here, because they require the Document definition, but we really want to inline them.
@@ -1542,8 +1577,10 @@ inline Node::Node(Document* document, ConstructionType type)
     trackForDebugging();
 #endif
     InspectorCounters::incrementCounter(InspectorCounters::NodeCounter);
+    // WebERA: Nodes are named in the action log by their creation order.
+    ActionLogRegisterObject(this);
     // SRL: Creating a logged so that following events on it are marked after it.
-    ActionLogFormat(ActionLog::WRITE_MEMORY, "NodeTree:%p", static_cast<void*>(this));
+    ActionLogFormat(ActionLog::WRITE_MEMORY, "NodeTree:%s", ActionLogObjectName(this).data());
 }
 
 Node* eventTargetNodeForDocument(Document*);
@@ -2052,6 +2052,9 @@ void Element::willModifyAttribute(const QualifiedName& name, const AtomicString&
     else if (name == HTMLNames::nameAttr)
         updateName(oldValue, newValue);
 
+    if (inDocument())
+        document()->contentHashAttributeChanged(this, name, oldValue, newValue);
+
 #if ENABLE(MUTATION_OBSERVERS)
     if (OwnPtr<MutationObserverInterestGroup> recipients = MutationObserverInterestGroup::createForAttributesMutation(this, name))
         recipients->enqueueMutationRecord(MutationRecord::createAttributes(this, name, oldValue));
@@ -2067,8 +2070,8 @@ void Element::didAddAttribute(Attribute* attr)
     attributeChanged(attr);
     InspectorInstrumentation::didModifyDOMAttr(document(), this, attr->name().localName(), attr->value());
     // SRL: Updating an attribute is recorded as a write to the corresponding field of the object.
-    ActionLogFormat(ActionLog::WRITE_MEMORY, "DOMNode[%p].%s",
-    		static_cast<void*>(this), attr->name().localName().string().ascii().data());
+    ActionLogFormat(ActionLog::WRITE_MEMORY, "DOMNode[%s].%s",
+    		ActionLogObjectName(this).data(), attr->name().localName().string().ascii().data());
     // TODO(WebERA-HB-REVIEW): User interface modification, add happens before?
     dispatchSubtreeModifiedEvent();
 }
@@ -2078,8 +2081,8 @@ void Element::didModifyAttribute(Attribute* attr)
     attributeChanged(attr);
     InspectorInstrumentation::didModifyDOMAttr(document(), this, attr->name().localName(), attr->value());
     // SRL: Updating an attribute is recorded as a write to the corresponding field of the object.
-    ActionLogFormat(ActionLog::WRITE_MEMORY, "DOMNode[%p].%s",
-    		static_cast<void*>(this), attr->name().localName().string().ascii().data());
+    ActionLogFormat(ActionLog::WRITE_MEMORY, "DOMNode[%s].%s",
+    		ActionLogObjectName(this).data(), attr->name().localName().string().ascii().data());
     // TODO(WebERA-HB-REVIEW): User interface modification, add happens before?
     // Do not dispatch a DOMSubtreeModified event here; see bug 81141.
 }
@@ -2089,8 +2092,8 @@ void Element::didRemoveAttribute(const QualifiedName& name)
     Attribute dummyAttribute(name, nullAtom);
     attributeChanged(&dummyAttribute);
     // SRL: Updating an attribute is recorded as a write to the corresponding field of the object.
-    ActionLogFormat(ActionLog::WRITE_MEMORY, "DOMNode[%p].%s",
-    		static_cast<void*>(this), name.localName().string().ascii().data());
+    ActionLogFormat(ActionLog::WRITE_MEMORY, "DOMNode[%s].%s",
+    		ActionLogObjectName(this).data(), name.localName().string().ascii().data());
     // TODO(WebERA-HB-REVIEW): User interface modification, add happens before?
     InspectorInstrumentation::didRemoveDOMAttr(document(), this, name.localName());
     dispatchSubtreeModifiedEvent();
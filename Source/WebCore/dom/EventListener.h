@@ -21,6 +21,7 @@
 #ifndef EventListener_h
 #define EventListener_h
 
+#include <wtf/ActionLogReport.h>
 #include <wtf/RefCounted.h>
 
 namespace JSC {
@@ -46,7 +47,7 @@ namespace WebCore {
             NativeEventListenerType
         };
 
-        virtual ~EventListener() { }
+        virtual ~EventListener() { ActionLogUnregisterObject(this); }
         virtual bool operator==(const EventListener&) = 0;
         virtual void handleEvent(ScriptExecutionContext*, Event*) = 0;
         virtual bool wasCreatedFromMarkup() const { return false; }
@@ -62,6 +63,8 @@ namespace WebCore {
         EventListener(Type type)
             : m_type(type)
         {
+            // WebERA: Listeners are named in the action log by their creation order.
+            ActionLogRegisterObject(this);
         }
 
     private:
@@ -81,6 +81,9 @@ EventTargetData::~EventTargetData()
 
 EventTarget::~EventTarget()
 {
+    // WebERA: Targets are named lazily when their listeners are accessed, forget the name with the target.
+    ActionLogUnregisterObject(this);
+
 	// SRL: Tell the auto-exploration that no more events can be accepted.
     if (toNode() != 0) {
         getEventAttachLog()->removeEventTarget(toNode());
@@ -102,9 +105,9 @@ namespace {
 void EventTargetAccess(ActionLog::CommandType command, EventTarget* target, const char* eventType) {
 	Node* node = target->toNode();
 	ActionLogFormat(command,
-			"%s[%p].%s",
+			"%s[%s].%s",
 			node ? (node->nodeName().isEmpty() ? "" : node->nodeName().ascii().data()) : "",
-			static_cast<void*>(node ? node : target),
+			ActionLogObjectName(node ? static_cast<void*>(node) : static_cast<void*>(target)).data(),
 			eventType);
 }
 }  // namespace
@@ -114,7 +117,7 @@ bool EventTarget::addEventListener(const AtomicString& eventType, PassRefPtr<Eve
 	// SRL: This is a write to the set of events.
 	ActionLogScope scope("addEventListener");
 	EventTargetAccess(ActionLog::WRITE_MEMORY, this, eventType.string().ascii().data());
-	ActionLogFormat(ActionLog::MEMORY_VALUE, "Event[%p]", static_cast<void*>(listener.get()));
+	ActionLogFormat(ActionLog::MEMORY_VALUE, "Event[%s]", ActionLogObjectName(listener.get()).data());
 
     // SRL: Note that an event listener was added for the auto-exploration to run it later.
     if (toNode() != 0) { // WebERA: && !toNode()->baseURI().string().isNull() <-- problematic on some websites?
@@ -233,7 +236,7 @@ bool EventTarget::fireEventListeners(Event* event)
         return true;
 
     // SRL: Firing an event at a node means the node does exist. This is a read to it.
-    ActionLogFormat(ActionLog::READ_MEMORY, "NodeTree:%p", static_cast<void*>(this));
+    ActionLogFormat(ActionLog::READ_MEMORY, "NodeTree:%s", ActionLogObjectName(this).data());
     // SRL: event firing is equivalent to a read from the event listener memory location.
     EventTargetAccess(ActionLog::READ_MEMORY, this, event->type().string().ascii().data());
 
@@ -398,6 +398,8 @@ void Node::trackForDebugging()
 
 Node::~Node()
 {
+    ActionLogUnregisterObject(this);
+
 #ifndef NDEBUG
     getEventAttachLog()->removeEventTarget(this);
 
@@ -2428,16 +2430,20 @@ ScriptExecutionContext* Node::scriptExecutionContext() const
 Node::InsertionNotificationRequest Node::insertedInto(Node* insertionPoint)
 {
     ASSERT(insertionPoint->inDocument() || isContainerNode());
-    if (insertionPoint->inDocument())
+    if (insertionPoint->inDocument()) {
         setFlag(InDocumentFlag);
+        document()->contentHashNodeInserted(this);
+    }
     return InsertionDone;
 }
 
 void Node::removedFrom(Node* insertionPoint)
 {
     ASSERT(insertionPoint->inDocument() || isContainerNode());
-    if (insertionPoint->inDocument())
+    if (insertionPoint->inDocument()) {
         clearFlag(InDocumentFlag);
+        document()->contentHashNodeRemoved(this, insertionPoint);
+    }
 }
 
 void Node::didMoveToNewDocument(Document* oldDocument)
@@ -58,10 +58,15 @@ DeferAsyncScriptExecution::DeferAsyncScriptExecution(const PendingScript& script
     m_timer.setEventActionDescriptor(descriptor);
     m_timer.startOneShot(0);
     m_timer.ignoreFireIntervalForHappensBefore();
+
+    // WebERA: Name this execution in the action log by its creation order.
+    ActionLogRegisterObject(this);
 }
 
 DeferAsyncScriptExecution::~DeferAsyncScriptExecution()
 {
+    ActionLogUnregisterObject(this);
+
     if (m_timer.isActive() || m_suspended) {
         m_timer.stop();
         m_document->decrementLoadEventDelayCount();
@@ -77,8 +82,8 @@ void DeferAsyncScriptExecution::timerFired(Timer<DeferAsyncScriptExecution> *tim
     CachedScript* cachedScript = m_script.cachedScript();
     RefPtr<Element> element = m_script.releaseElementAndClear();
     ScriptElement* script = toScriptElement(element.get());
-    ActionLogFormat(ActionLog::READ_MEMORY, "ScriptRunner-%p-%p",
-            static_cast<void*>(this), static_cast<void*>(script));
+    ActionLogFormat(ActionLog::READ_MEMORY, "ScriptRunner-%s-%s",
+            ActionLogObjectName(this).data(), ActionLogObjectName(script->element()).data());
     script->execute(cachedScript);
     m_document->decrementLoadEventDelayCount();
 
@@ -121,10 +126,14 @@ ScriptRunner::ScriptRunner(Document* document)
     , m_suspended(false)
 {
     ASSERT(document);
+    // WebERA: Name the runner in the action log by its creation order.
+    ActionLogRegisterObject(this);
 }
 
 ScriptRunner::~ScriptRunner()
 {
+    ActionLogUnregisterObject(this);
+
     for (size_t i = 0; i < m_scriptsToExecuteSoon.size(); ++i)
         m_document->decrementLoadEventDelayCount();
     for (size_t i = 0; i < m_scriptsToExecuteInOrder.size(); ++i)
@@ -155,8 +164,8 @@ void ScriptRunner::queueScriptForExecution(ScriptElement* scriptElement, CachedR
 
     case IN_ORDER_EXECUTION:
         m_scriptsToExecuteInOrder.append(PendingScript(element, cachedScript.get()));
-        ActionLogFormat(ActionLog::WRITE_MEMORY, "ScriptRunner-%p-%p",
-        		static_cast<void*>(this), static_cast<void*>(scriptElement));
+        ActionLogFormat(ActionLog::WRITE_MEMORY, "ScriptRunner-%s-%s",
+        		ActionLogObjectName(this).data(), ActionLogObjectName(scriptElement->element()).data());
         break;
     }
 }
@@ -187,8 +196,8 @@ void ScriptRunner::resume()
 
 void ScriptRunner::notifyScriptReady(ScriptElement* scriptElement, ExecutionType executionType)
 {
-    ActionLogFormat(ActionLog::WRITE_MEMORY, "ScriptRunner-%p-%p",
-            static_cast<void*>(this), static_cast<void*>(scriptElement));
+    ActionLogFormat(ActionLog::WRITE_MEMORY, "ScriptRunner-%s-%s",
+            ActionLogObjectName(this).data(), ActionLogObjectName(scriptElement->element()).data());
 
     std::pair<unsigned int, PendingScript> elm;
 
@@ -249,8 +258,8 @@ void ScriptRunner::inOrderTimerFired(Timer<ScriptRunner>* timer)
     CachedScript* cachedScript = pendingScript.cachedScript();
     RefPtr<Element> element = pendingScript.releaseElementAndClear();
     ScriptElement* script = toScriptElement(element.get());
-    ActionLogFormat(ActionLog::READ_MEMORY, "ScriptRunner-%p-%p",
-            static_cast<void*>(this), static_cast<void*>(script));
+    ActionLogFormat(ActionLog::READ_MEMORY, "ScriptRunner-%s-%s",
+            ActionLogObjectName(this).data(), ActionLogObjectName(script->element()).data());
     script->execute(cachedScript);
     m_document->decrementLoadEventDelayCount();
 
@@ -180,6 +180,9 @@ void StyledElement::parseAttribute(Attribute* attr)
         setIsStyleAttributeValid();
         setNeedsStyleRecalc();
         InspectorInstrumentation::didInvalidateStyleAttr(document(), this);
+        // WebERA: The content hash tracks the inline style rather than the style attribute
+        if (inDocument())
+            document()->contentHashNodeChanged(this);
     }
 }
 
@@ -188,6 +191,9 @@ void StyledElement::inlineStyleChanged()
     setNeedsStyleRecalc(InlineStyleChange);
     setIsStyleAttributeValid(false);
     InspectorInstrumentation::didInvalidateStyleAttr(document(), this);
+    // WebERA: The style attribute is synchronized lazily, update the content hash from the inline style now
+    if (inDocument())
+        document()->contentHashNodeChanged(this);
 }
     
 bool StyledElement::setInlineStyleProperty(CSSPropertyID propertyID, int identifier, bool important)
@@ -80,9 +80,9 @@ Element* TreeScope::getElementById(const AtomicString& elementId) const
         return 0;
     // SRL: The id of the element is a memory location. This is a read.
     ActionLogFormat(ActionLog::READ_MEMORY,
-    		"Tree[%p]:%s", static_cast<const void*>(this), elementId.string().ascii().data());
+    		"Tree[%s]:%s", ActionLogObjectName(rootNode()).data(), elementId.string().ascii().data());
     Element* result = m_elementsById.getElementById(elementId.impl(), this);
-    ActionLogFormat(ActionLog::MEMORY_VALUE, "DOMNode[%p]", static_cast<void*>(result));
+    ActionLogFormat(ActionLog::MEMORY_VALUE, "DOMNode[%s]", ActionLogObjectName(result).data());
     return result;
 }
 
@@ -90,8 +90,8 @@ void TreeScope::addElementById(const AtomicString& elementId, Element* element)
 {
 	// SRL: The id of the element is a memory location. This is a write.
     ActionLogFormat(ActionLog::WRITE_MEMORY,
-    		"Tree[%p]:%s", static_cast<const void*>(this), elementId.string().ascii().data());
-    ActionLogFormat(ActionLog::MEMORY_VALUE, "DOMNode[%p]", static_cast<void*>(element));
+    		"Tree[%s]:%s", ActionLogObjectName(rootNode()).data(), elementId.string().ascii().data());
+    ActionLogFormat(ActionLog::MEMORY_VALUE, "DOMNode[%s]", ActionLogObjectName(element).data());
 
     m_elementsById.add(elementId.impl(), element);
 }
@@ -103,7 +103,7 @@ void TreeScope::removeElementById(const AtomicString& elementId, Element* elemen
     if (HBIsCurrentEventActionValid()) {
         // SRL: The id of the element is a memory location. This is a write.
         ActionLogFormat(ActionLog::WRITE_MEMORY,
-                "Tree[%p]:%s", static_cast<const void*>(this), elementId.string().ascii().data());
+                "Tree[%s]:%s", ActionLogObjectName(rootNode()).data(), elementId.string().ascii().data());
         ActionLogFormat(ActionLog::MEMORY_VALUE, "undefined");
     }
 
@@ -505,7 +505,7 @@ void HTMLAnchorElement::handleClick(Event* event)
         return;
 
     ActionLogScope scopeName("fire:click @ AnchorElement");
-    ActionLogFormat(ActionLog::READ_MEMORY, "NodeTree:%p", static_cast<void*>(this));
+    ActionLogFormat(ActionLog::READ_MEMORY, "NodeTree:%s", ActionLogObjectName(this).data());
 
     String url = stripLeadingAndTrailingHTMLSpaces(fastGetAttribute(hrefAttr));
     appendServerMapMousePosition(url, event);
@@ -177,6 +177,8 @@ CachedResource::CachedResource(const ResourceRequest& request, Type type)
 #ifndef NDEBUG
     cachedResourceLeakCounter.increment();
 #endif
+    // WebERA: Resources are named in the action log by their creation order.
+    ActionLogRegisterObject(this);
 }
 
 CachedResource::~CachedResource()
@@ -186,7 +188,9 @@ CachedResource::~CachedResource()
     ASSERT(!inCache());
     ASSERT(!m_deleted);
     ASSERT(url().isNull() || memoryCache()->resourceForURL(KURL(ParsedURLString, url())) != this);
-    
+
+    ActionLogUnregisterObject(this);
+
 #ifndef NDEBUG
     m_deleted = true;
     cachedResourceLeakCounter.decrement();
@@ -252,7 +256,7 @@ void CachedResource::checkNotify()
 
     CachedResourceClientWalker<CachedResourceClient> w(m_clients);
     while (CachedResourceClient* c = w.next()) {
-    	ActionLogFormat(ActionLog::READ_MEMORY, "CachedResource-%p-%p", this, c);
+    	ActionLogFormat(ActionLog::READ_MEMORY, "CachedResource-%s-%s", ActionLogObjectName(this).data(), ActionLogObjectName(c).data());
         c->notifyFinished(this);
     }
 }
@@ -397,7 +401,7 @@ void CachedResource::didAddClient(CachedResourceClient* c)
     	// This is an ad-hoc synchonization that the eventracer raceanalyzer will convert
     	// to a happens-before edge.
         if (HBIsCurrentEventActionValid()) {
-    		ActionLogFormat(ActionLog::WRITE_MEMORY, "CachedResource-%p-%p", this, c);
+    		ActionLogFormat(ActionLog::WRITE_MEMORY, "CachedResource-%s-%s", ActionLogObjectName(this).data(), ActionLogObjectName(c).data());
     	}
 
         // TODO(WebERA-HB-REVIEW): Explain to (Casper) what an ad-hoc synchonization exactly is, could we not add a real HB relation here?
@@ -438,7 +442,7 @@ bool CachedResource::addClientToSet(CachedResourceClient* client)
 	// This is an ad-hoc synchonization that the eventracer raceanalyzer will convert
 	// to a happens-before edge.
     if (HBIsCurrentEventActionValid()) {
-    	ActionLogFormat(ActionLog::WRITE_MEMORY, "CachedResource-%p-%p", this, client);
+    	ActionLogFormat(ActionLog::WRITE_MEMORY, "CachedResource-%s-%s", ActionLogObjectName(this).data(), ActionLogObjectName(client).data());
     }
 
     // TODO(WebERA-HB-REVIEW): Explain to (Casper) what an ad-hoc synchonization exactly is, could we not add a real HB relation here?
@@ -25,6 +25,7 @@
 #ifndef CachedResourceClient_h
 #define CachedResourceClient_h
 
+#include <wtf/ActionLogReport.h>
 #include <wtf/FastAllocBase.h>
 #include <wtf/Forward.h>
 
@@ -45,7 +46,7 @@ public:
         RawResourceType
     };
 
-    virtual ~CachedResourceClient() { }
+    virtual ~CachedResourceClient() { ActionLogUnregisterObject(this); }
     virtual void notifyFinished(CachedResource*) { }
     virtual void didReceiveData(CachedResource*) { };
     
@@ -135,6 +135,12 @@ static void printMessageSourceAndLevelPrefix(MessageSource source, MessageLevel
     printf("%s %s:", sourceString, levelString);
 }
 
+// WebERA: Renders the message as details of a warning, only invoked if the warning collector keeps them
+static void renderConsoleMessage(std::ostream& out, void* context)
+{
+    out << static_cast<String*>(context)->ascii().data();
+}
+
 void Console::addMessage(MessageSource source, MessageType type, MessageLevel level, const String& message, PassRefPtr<ScriptCallStack> callStack)
 {
     addMessage(source, type, level, message, String(), 0, callStack);
@@ -209,7 +215,7 @@ void Console::addMessage(MessageSource source, MessageType type, MessageLevel le
     std::stringstream name;
     name << sourceString << " (" << levelString << ")";
 
-    WTF::WarningCollectorReport("console.log", name.str(), message.ascii().data());
+    WTF::WarningCollectorReport("console.log", name.str(), &renderConsoleMessage, const_cast<String*>(&message));
 
     if (!Console::shouldPrintExceptions())
         return;
@@ -276,7 +282,7 @@ void Console::addMessage(MessageType type, MessageLevel level, PassRefPtr<Script
         name << "CONSOLE (" << levelString << ")";
 
 
-        WTF::WarningCollectorReport("console.log", name.str(), message.ascii().data());
+        WTF::WarningCollectorReport("console.log", name.str(), &renderConsoleMessage, const_cast<String*>(&message));
         page->chrome()->client()->addMessageToConsole(ConsoleAPIMessageSource, type, level, message, lastCaller.lineNumber(), lastCaller.sourceURL());
     }
 
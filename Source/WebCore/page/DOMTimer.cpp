@@ -34,6 +34,7 @@
 #include <wtf/ActionLogReport.h>
 #include <wtf/EventActionDescriptor.h>
 #include <wtf/HashSet.h>
+#include <wtf/SequenceRegistry.h>
 #include <wtf/StdLibExtras.h>
 
 #include <string>
@@ -79,6 +80,8 @@ DOMTimer::DOMTimer(ScriptExecutionContext* context, PassOwnPtr<ScheduledAction>
     , m_shouldForwardUserGesture(shouldForwardUserGesture(interval, m_nestingLevel))
 {
     scriptExecutionContext()->addTimeout(m_timeoutId, this);
+    // WebERA: Name the timer in the action log by its creation order.
+    ActionLogRegisterObject(this);
 
     double intervalMilliseconds = intervalClampedToMinimum(interval, context->minimumTimerInterval());
     if (singleShot)
@@ -89,6 +92,7 @@ DOMTimer::DOMTimer(ScriptExecutionContext* context, PassOwnPtr<ScheduledAction>
 
 DOMTimer::~DOMTimer()
 {
+    ActionLogUnregisterObject(this);
     if (scriptExecutionContext())
         scriptExecutionContext()->removeTimeout(m_timeoutId);
 }
@@ -119,7 +123,7 @@ int DOMTimer::install(ScriptExecutionContext* context, PassOwnPtr<ScheduledActio
 
     // SRL: Record a write to a timer with the given id when the timer is created.
     ActionLogFormat(ActionLog::WRITE_MEMORY, "Timer:%d", timer->m_timeoutId);
-    ActionLogFormat(ActionLog::MEMORY_VALUE, "DOMTimer[%p]", static_cast<void*>(timer));
+    ActionLogFormat(ActionLog::MEMORY_VALUE, "DOMTimer[%s]", ActionLogObjectName(timer).data());
 
     WTF::EventActionDescriptor descriptor(WTF::TIMER, "DOMTimer", params.str());
     timer->setEventActionDescriptor(descriptor);
@@ -170,7 +174,7 @@ void DOMTimer::fired()
 
         // SRL: Record a timer read when it fires.
         ActionLogFormat(ActionLog::READ_MEMORY, "Timer:%d", m_timeoutId);
-        ActionLogFormat(ActionLog::MEMORY_VALUE, "DOMTimer[%p]", static_cast<void*>(this));
+        ActionLogFormat(ActionLog::MEMORY_VALUE, "DOMTimer[%s]", ActionLogObjectName(this).data());
 
         // No access to member variables after this point, it can delete the timer.
         m_action->execute(context);
@@ -225,27 +229,22 @@ void DOMTimer::adjustMinimumTimerInterval(double oldMinimumTimerInterval)
     augmentFireInterval(newClampedInterval - previousClampedInterval);
 }
 
-std::map<std::string, unsigned int> DOMTimer::m_nextSameUrlSequenceNumber;
+static SequenceRegistry& sameUrlSequenceNumbers()
+{
+    DEFINE_STATIC_LOCAL(SequenceRegistry, registry, ());
+    return registry;
+}
 
 unsigned int DOMTimer::getNextSameUrlSequenceNumber(const std::string& url, uint line, WTF::EventActionId eventActionId)
 {
-    std::stringstream ident;
-    ident << url << "-" << line << (int)eventActionId;
-
-    std::map<std::string, unsigned int>::iterator iter = DOMTimer::m_nextSameUrlSequenceNumber.find(ident.str());
-
-    unsigned int id = 0;
-
-    if (iter != DOMTimer::m_nextSameUrlSequenceNumber.end()) {
-        id = (*iter).second;
-
-        (*iter).second++;
-
-    } else {
-        DOMTimer::m_nextSameUrlSequenceNumber.insert(std::pair<std::string, unsigned int>(ident.str(), 1));
-    }
+    SequenceRegistry::Key key;
+    key.add(url.data(), url.size()).add(line).add(eventActionId);
+    return sameUrlSequenceNumbers().next(key);
+}
 
-    return id;
+void DOMTimer::resetSameUrlSequenceNumbers()
+{
+    sameUrlSequenceNumbers().reset();
 }
 
 double DOMTimer::intervalClampedToMinimum(int timeout, double minimumTimerInterval) const
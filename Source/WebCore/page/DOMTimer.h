@@ -27,7 +27,6 @@
 #ifndef DOMTimer_h
 #define DOMTimer_h
 
-#include <map>
 #include <string>
 
 #include "SuspendableTimer.h"
@@ -72,6 +71,8 @@ namespace WebCore {
         void adjustMinimumTimerInterval(double oldMinimumTimerInterval);
 
         static unsigned int getNextSameUrlSequenceNumber(const std::string& url, uint line, WTF::EventActionId);
+        // Called when a new page is loaded.
+        static void resetSameUrlSequenceNumbers();
 
     private:
         DOMTimer(ScriptExecutionContext*, PassOwnPtr<ScheduledAction>, int interval, bool singleShot);
@@ -90,8 +91,6 @@ namespace WebCore {
         int m_originalInterval;
         bool m_shouldForwardUserGesture;
         static double s_minDefaultTimerInterval;
-
-        static std::map<std::string, unsigned int> m_nextSameUrlSequenceNumber;
     };
 
 } // namespace WebCore
@@ -3034,6 +3034,10 @@ void FrameView::paintContents(GraphicsContext* p, const IntRect& rect)
     if (!frame())
         return;
 
+    // WebERA: Analysis runs skip painting until a screenshot is taken. Printing is never suppressed.
+    if (m_frame->settings() && m_frame->settings()->paintingSuppressed() && !m_frame->document()->printing())
+        return;
+
     InspectorInstrumentationCookie cookie = InspectorInstrumentation::willPaint(m_frame.get(), p, rect);
 
     Document* document = m_frame->document();
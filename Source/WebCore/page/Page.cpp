@@ -140,17 +140,24 @@ DebuggerListener::DebuggerListener()
 {
 }
 
-void DebuggerListener::exception(const JSC::DebuggerCallFrame& callFrame, intptr_t sourceID, int lineNumber, bool hasHandler)
-{
-    JSC::SourceProvider* sp = reinterpret_cast<JSC::SourceProvider*>(sourceID); // sourceID is just a casted pointer to the provider
+struct ExceptionDetails {
+    const JSC::DebuggerCallFrame* callFrame;
+    JSC::SourceProvider* sourceProvider;
+    int lineNumber;
+    bool hasHandler;
+};
 
-    std::stringstream detail;
+static void renderExceptionDetails(std::ostream& detail, void* context)
+{
+    ExceptionDetails* exception = static_cast<ExceptionDetails*>(context);
+    const JSC::DebuggerCallFrame& callFrame = *exception->callFrame;
+    JSC::SourceProvider* sp = exception->sourceProvider;
 
     JSC::UString ex = callFrame.exceptionString();
 
     std::string prefix = "";
 
-    if (!hasHandler) {
+    if (!exception->hasHandler) {
         prefix = "Uncaught ";
     }
 
@@ -164,7 +171,7 @@ void DebuggerListener::exception(const JSC::DebuggerCallFrame& callFrame, intptr
         detail << "File: " << sp->url().ascii().data() << std::endl;
     }
 
-    detail << "Linenumber: " << lineNumber << std::endl;
+    detail << "Linenumber: " << exception->lineNumber << std::endl;
 
     JSC::UString cfunc = callFrame.calculatedFunctionName();
     if (!cfunc.isNull()) {
@@ -175,12 +182,22 @@ void DebuggerListener::exception(const JSC::DebuggerCallFrame& callFrame, intptr
     if (func != 0 && !func->isNull()) {
         detail << "Function: " << func->ascii().data() << std::endl;
     }
+}
+
+void DebuggerListener::exception(const JSC::DebuggerCallFrame& callFrame, intptr_t sourceID, int lineNumber, bool hasHandler)
+{
+    ExceptionDetails exception;
+    exception.callFrame = &callFrame;
+    exception.sourceProvider = reinterpret_cast<JSC::SourceProvider*>(sourceID); // sourceID is just a casted pointer to the provider
+    exception.lineNumber = lineNumber;
+    exception.hasHandler = hasHandler;
 
     // NOTICE: The linenumber announced by the interpreter points to the line of a code block in which an exception occured,
     // and not the line throwing the exception.
     // Thus, this value is identical with sp->startPosition().m_line.zeroBasedInt() + 1 (start line of source provider)
 
-    WTF::WarningCollectorReport("JavaScript_Interpreter", "An exception occured", detail.str());
+    // The details are only rendered if the warning collector keeps them
+    WTF::WarningCollectorReport("JavaScript_Interpreter", "An exception occured", &renderExceptionDetails, &exception);
 }
 
 static DebuggerListener* debuggerListener = new DebuggerListener();
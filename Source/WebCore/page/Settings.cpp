@@ -215,6 +215,7 @@ Settings::Settings(Page* page)
     , m_deferredCanvas2dEnabled(false)
     , m_loadDeferringEnabled(true)
     , m_tiledBackingStoreEnabled(false)
+    , m_paintingSuppressed(false)
     , m_paginateDuringLayoutEnabled(false)
     , m_dnsPrefetchingEnabled(false)
 #if ENABLE(FULLSCREEN_API)
@@ -891,6 +892,18 @@ void Settings::setTiledBackingStoreEnabled(bool enabled)
 #endif
 }
 
+void Settings::setPaintingSuppressed(bool suppressed)
+{
+    if (m_paintingSuppressed == suppressed)
+        return;
+
+    m_paintingSuppressed = suppressed;
+
+    // Nothing was painted while suppressed, the next paint has to cover the whole view.
+    if (!suppressed && m_page->mainFrame() && m_page->mainFrame()->view())
+        m_page->mainFrame()->view()->invalidate();
+}
+
 void Settings::setMockScrollbarsEnabled(bool flag)
 {
     gMockScrollbarsEnabled = flag;
@@ -402,6 +402,11 @@ namespace WebCore {
         void setTiledBackingStoreEnabled(bool);
         bool tiledBackingStoreEnabled() const { return m_tiledBackingStoreEnabled; }
 
+        // WebERA: Layout is kept up to date, but FrameView does not paint and the chrome client does not update
+        // the backing store. Used by the analysis runs, which only paint for the final screenshot.
+        void setPaintingSuppressed(bool);
+        bool paintingSuppressed() const { return m_paintingSuppressed; }
+
         void setPaginateDuringLayoutEnabled(bool flag) { m_paginateDuringLayoutEnabled = flag; }
         bool paginateDuringLayoutEnabled() const { return m_paginateDuringLayoutEnabled; }
 
@@ -672,6 +677,7 @@ namespace WebCore {
         bool m_deferredCanvas2dEnabled : 1;
         bool m_loadDeferringEnabled : 1;
         bool m_tiledBackingStoreEnabled : 1;
+        bool m_paintingSuppressed : 1;
         bool m_paginateDuringLayoutEnabled : 1;
         bool m_dnsPrefetchingEnabled : 1;
 #if ENABLE(FULLSCREEN_API)
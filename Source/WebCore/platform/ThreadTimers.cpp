@@ -75,6 +75,7 @@ static MainThreadSharedTimer* mainThreadSharedTimer()
 ThreadTimers::ThreadTimers()
     : m_sharedTimer(0)
     , m_firingTimers(false)
+    , m_idleCallback(0)
 {
     if (isMainThread())
         setSharedTimer(mainThreadSharedTimer());
@@ -196,6 +197,10 @@ void ThreadTimers::sharedTimerFiredInternal()
 
     m_scheduler->executeDelayedEventActions(eventActionRegister());
 
+    // WebERA: Use the rest of the slice for idle work, unless we are in a nested event loop or more timers are due.
+    if (m_idleCallback && m_firingTimers && !hasTimersDueWithin(0) && monotonicallyIncreasingTime() < timeToQuit)
+        m_idleCallback(timeToQuit);
+
     m_firingTimers = false;
 
     updateSharedTimer();
@@ -207,6 +212,36 @@ void ThreadTimers::deregisterEventActionHandler(TimerBase* timer)
     m_scheduler->eventActionDescheduled(timer->eventActionDescriptor(), eventActionRegister());
 }
 
+bool ThreadTimers::hasTimersDueWithin(double seconds) const
+{
+    if (m_timerHeap.isEmpty())
+        return false;
+
+    return m_timerHeap.first()->m_nextFireTime <= monotonicallyIncreasingTime() + seconds;
+}
+
+bool ThreadTimers::hasOneShotTimersDueWithin(double seconds) const
+{
+    double limit = monotonicallyIncreasingTime() + seconds;
+
+    for (size_t i = 0; i < m_timerHeap.size(); ++i) {
+        if (!m_timerHeap[i]->m_repeatInterval && m_timerHeap[i]->m_nextFireTime <= limit)
+            return true;
+    }
+
+    return false;
+}
+
+bool ThreadTimers::hasOneShotTimers() const
+{
+    for (size_t i = 0; i < m_timerHeap.size(); ++i) {
+        if (!m_timerHeap[i]->m_repeatInterval)
+            return true;
+    }
+
+    return false;
+}
+
 void ThreadTimers::fireTimersInNestedEventLoop()
 {
     // Reset the reentrancy guard so the timers can fire again.
@@ -90,6 +90,18 @@ namespace WebCore {
 
         void deregisterEventActionHandler(TimerBase* timer);
 
+        // True if a timer is due to fire within the given number of seconds
+        bool hasTimersDueWithin(double seconds) const;
+
+        // As above, ignoring repeating timers (e.g. setInterval), which are always pending
+        bool hasOneShotTimersDueWithin(double seconds) const;
+        bool hasOneShotTimers() const;
+
+        // Called with the end of the current timer slice (in monotonic time) once the due timers and
+        // event actions have run, e.g. to sweep the JS heap between event actions.
+        typedef void (*IdleCallback)(double deadline);
+        void setIdleCallback(IdleCallback callback) { m_idleCallback = callback; }
+
     private:
         static void sharedTimerFired();
 
@@ -101,6 +113,7 @@ namespace WebCore {
         Vector<TimerBase*> m_timerHeap;
         SharedTimer* m_sharedTimer; // External object, can be a run loop on a worker thread. Normally set/reset by worker thread.
         bool m_firingTimers; // Reentrancy guard.
+        IdleCallback m_idleCallback;
 
         // WebERA
 
@@ -366,6 +366,10 @@ int BitmapImage::repetitionCount(bool imageKnownToBeComplete)
 
 bool BitmapImage::shouldAnimate()
 {
+    // WebERA: See ImageSource::setAnimationsStopped().
+    if (ImageSource::animationsStopped())
+        return false;
+
     return (repetitionCount(false) != cAnimationNone && !m_animationFinished && imageObserver());
 }
 
@@ -44,6 +44,9 @@ namespace WebCore {
 unsigned ImageSource::s_maxPixelsPerDecodedImage = 1024 * 1024;
 #endif
 
+bool ImageSource::s_metadataOnlyDecoding = false;
+bool ImageSource::s_animationsStopped = false;
+
 ImageSource::ImageSource(ImageSource::AlphaOption alphaOption, ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption)
     : m_decoder(0)
     , m_alphaOption(alphaOption)
@@ -199,6 +199,15 @@ public:
     static void setMaxPixelsPerDecodedImage(unsigned maxPixels) { s_maxPixelsPerDecodedImage = maxPixels; }
 #endif
 
+    // WebERA: Only decode what layout and the load events need (size, frame count) until the pixels of a frame
+    // are requested by a paint or a pixel read (e.g. canvas drawImage).
+    static bool metadataOnlyDecoding() { return s_metadataOnlyDecoding; }
+    static void setMetadataOnlyDecoding(bool metadataOnly) { s_metadataOnlyDecoding = metadataOnly; }
+
+    // WebERA: Keep animated images on their first frame, instead of decoding every further frame on a wall clock timer.
+    static bool animationsStopped() { return s_animationsStopped; }
+    static void setAnimationsStopped(bool stopped) { s_animationsStopped = stopped; }
+
 private:
     NativeImageSourcePtr m_decoder;
     AlphaOption m_alphaOption;
@@ -206,6 +215,8 @@ private:
 #if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
     static unsigned s_maxPixelsPerDecodedImage;
 #endif
+    static bool s_metadataOnlyDecoding;
+    static bool s_animationsStopped;
 };
 
 }
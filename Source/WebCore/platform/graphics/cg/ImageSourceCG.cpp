@@ -70,6 +70,9 @@ void sharedBufferRelease(void* info)
 }
 #endif
 
+bool ImageSource::s_metadataOnlyDecoding = false;
+bool ImageSource::s_animationsStopped = false;
+
 ImageSource::ImageSource(ImageSource::AlphaOption alphaOption, ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption)
     : m_decoder(0)
     // FIXME: m_premultiplyAlpha is ignored in cg at the moment.
@@ -100,6 +100,11 @@ size_t ImageDecoderQt::frameCount()
         if (m_reader->supportsAnimation()) {
             int imageCount = m_reader->imageCount();
 
+            // WebERA: Counting the frames below decodes all of them, only the first frame is shown when
+            // decoding metadata only.
+            if (!imageCount && ImageSource::metadataOnlyDecoding())
+                imageCount = 1;
+
             // Fixup for Qt decoders... imageCount() is wrong
             // and jumpToNextImage does not work either... so
             // we will have to parse everything...
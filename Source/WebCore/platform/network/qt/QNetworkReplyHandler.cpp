@@ -43,6 +43,8 @@
 
 #include <wtf/EventActionDescriptor.h>
 #include <wtf/ActionLogReport.h>
+#include <wtf/SequenceRegistry.h>
+#include <wtf/StdLibExtras.h>
 
 #include <wtf/text/CString.h>
 
@@ -206,12 +208,14 @@ bool FormDataIODevice::isSequential() const
 
 /****************** QNetworkReplySnapshot ******************/
 
-QNetworkReplyInitialSnapshot::QNetworkReplyInitialSnapshot(QNetworkReply* reply)
+QNetworkReplyInitialSnapshot::QNetworkReplyInitialSnapshot(QNetworkReply* reply, const QSharedPointer<QNetworkReplySpillFile>& spillFile)
     : m_headers(reply->rawHeaderPairs())
     , m_sameUrlSequenceNumber(QNetworkReplyInitialSnapshot::getNextSameUrlSequenceNumber(reply->url()))
     , m_url(reply->url())
     , m_streamPosition(0)
+    , m_tokenScanPosition(0)
 {
+    m_stream.setSpillFile(spillFile);
     m_stream.append(reply->readAll());
     takeSnapshot(QNetworkReplyInitialSnapshot::INITIAL, reply);
 
@@ -223,6 +227,7 @@ QNetworkReplyInitialSnapshot::QNetworkReplyInitialSnapshot(QNetworkReply* reply)
 
 QNetworkReplyInitialSnapshot::QNetworkReplyInitialSnapshot()
     : m_streamPosition(0)
+    , m_tokenScanPosition(0)
 {
 }
 
@@ -241,6 +246,55 @@ QNetworkReplySnapshot* QNetworkReplyInitialSnapshot::takeSnapshot(NetworkSignal
     return m_snapshots.last().second;
 }
 
+void QNetworkReplyInitialSnapshot::appendData(QNetworkReply* reply)
+{
+    m_stream.append(reply->readAll());
+}
+
+QNetworkReplySnapshot* QNetworkReplyInitialSnapshot::takeSnapshot(NetworkSignal signal, QNetworkReply* reply, qint64 streamSize)
+{
+    QNetworkReplySnapshot* snapshot = takeSnapshot(signal, reply);
+
+    ASSERT(streamSize <= snapshot->m_streamSize);
+    snapshot->m_streamSize = streamSize;
+
+    return snapshot;
+}
+
+qint64 QNetworkReplyInitialSnapshot::bytesNotInSnapshot() const
+{
+    return m_stream.size() - m_snapshots.last().second->m_streamSize;
+}
+
+qint64 QNetworkReplyInitialSnapshot::nextChunkBoundary(qint64 chunkSize, bool tokens)
+{
+    qint64 snapshotSize = m_snapshots.last().second->m_streamSize;
+    qint64 boundary = snapshotSize + chunkSize;
+
+    if (boundary > m_stream.size()) {
+        return -1;
+    }
+
+    if (!tokens) {
+        return boundary;
+    }
+
+    // Data scanned by an earlier call holds no token, and a chunk without tokens ends at a fixed size
+    qint64 limit = snapshotSize + 2 * chunkSize;
+    qint64 token = m_stream.indexOfAny(std::max(boundary - 1, m_tokenScanPosition), limit, ">\n");
+
+    if (token != -1) {
+        return token + 1;
+    }
+
+    if (limit <= m_stream.size()) {
+        return limit;
+    }
+
+    m_tokenScanPosition = m_stream.size();
+    return -1;
+}
+
 QByteArray QNetworkReplyInitialSnapshot::read(qint64 maxlen)
 {
     QByteArray chunk = peek(maxlen);
@@ -251,10 +305,25 @@ QByteArray QNetworkReplyInitialSnapshot::read(qint64 maxlen)
 
 QByteArray QNetworkReplyInitialSnapshot::peek(qint64 maxlen)
 {
-    qint64 chunkSize = std::min(maxlen, m_stream.size() - m_streamPosition);
-    QByteArray result(m_stream.data()+m_streamPosition, chunkSize);
+    return m_stream.copy(m_streamPosition, maxlen);
+}
+
+qint64 QNetworkReplyInitialSnapshot::readData(qint64 maxlen, const char** data, QByteArray* buffer)
+{
+    qint64 length = std::min(maxlen, m_stream.size() - m_streamPosition);
+    qint64 mapped = m_stream.mappedData(m_streamPosition, length, data);
+
+    if (mapped > 0) {
+        // Only return the mapped bytes, the rest (the next segment or the in-memory window) is returned by the next read
+        length = mapped;
+    } else if (length > 0) {
+        // Still in the in-memory window, fall back to a copy
+        *buffer = m_stream.copy(m_streamPosition, length);
+        *data = buffer->constData();
+    }
 
-    return result;
+    m_streamPosition += length;
+    return length;
 }
 
 void QNetworkReplyInitialSnapshot::serialize(QIODevice* stream) const
@@ -263,7 +332,7 @@ void QNetworkReplyInitialSnapshot::serialize(QIODevice* stream) const
     out << m_headers;
     out << m_sameUrlSequenceNumber;
     out << m_url;
-    out << m_stream;
+    m_stream.serialize(out);
     out << m_cookies;
 
     foreach (const QNetworkReplySnapshotEntry& entry, m_snapshots) {
@@ -277,7 +346,7 @@ void QNetworkReplyInitialSnapshot::serialize(QIODevice* stream) const
     out << (int)END;
 }
 
-QNetworkReplyInitialSnapshot* QNetworkReplyInitialSnapshot::deserialize(QIODevice* stream)
+QNetworkReplyInitialSnapshot* QNetworkReplyInitialSnapshot::deserialize(QIODevice* stream, const char* memory)
 {
     QNetworkReplyInitialSnapshot* initial = new QNetworkReplyInitialSnapshot();
 
@@ -285,9 +354,11 @@ QNetworkReplyInitialSnapshot* QNetworkReplyInitialSnapshot::deserialize(QIODevic
 
     in >> initial->m_headers
        >> initial->m_sameUrlSequenceNumber
-       >> initial->m_url
-       >> initial->m_stream
-       >> initial->m_cookies;
+       >> initial->m_url;
+
+    initial->m_stream.deserialize(in, memory);
+
+    in >> initial->m_cookies;
 
     while (true) {
         int signal;
@@ -314,21 +385,24 @@ QNetworkReplyInitialSnapshot* QNetworkReplyInitialSnapshot::deserialize(QIODevic
     return initial;
 }
 
-QHash<QString, unsigned int> QNetworkReplyInitialSnapshot::m_nextSameUrlSequenceNumber;
+static SequenceRegistry& sameUrlSequenceNumbers()
+{
+    DEFINE_STATIC_LOCAL(SequenceRegistry, registry, ());
+    return registry;
+}
 
 unsigned int QNetworkReplyInitialSnapshot::getNextSameUrlSequenceNumber(const QUrl& url)
 {
     QString urlString = url.toString();
-    QHash<QString, unsigned int>::const_iterator iter = QNetworkReplyInitialSnapshot::m_nextSameUrlSequenceNumber.find(urlString);
 
-    unsigned int id = 0;
-    if (iter != QNetworkReplyInitialSnapshot::m_nextSameUrlSequenceNumber.end()) {
-        id = (*iter);
-    }
-
-    QNetworkReplyInitialSnapshot::m_nextSameUrlSequenceNumber.insert(urlString, id+1);
+    SequenceRegistry::Key key;
+    key.add(reinterpret_cast<const UChar*>(urlString.utf16()), urlString.length());
+    return sameUrlSequenceNumbers().next(key);
+}
 
-    return id;
+void QNetworkReplyInitialSnapshot::resetSameUrlSequenceNumbers()
+{
+    sameUrlSequenceNumbers().reset();
 }
 
 QList<QNetworkCookie> QNetworkReplyInitialSnapshot::getCookies() {
@@ -502,7 +576,7 @@ void QNetworkReplyControllable::scheduleNextSnapshotUpdate()
 }
 
 QNetworkReplyControllableLive::QNetworkReplyControllableLive(QNetworkReplyControllableFactory* factory, QNetworkReply* reply, QObject* parent)
-    : QNetworkReplyControllable(factory, reply, new QNetworkReplyInitialSnapshot(reply), parent)
+    : QNetworkReplyControllable(factory, reply, new QNetworkReplyInitialSnapshot(reply, factory->spillFile()), parent)
 {
     connect(m_reply, SIGNAL(finished()), this, SLOT(slFinished()));
     connect(m_reply, SIGNAL(readyRead()), this, SLOT(slReadyRead()));
@@ -515,15 +589,45 @@ QNetworkReplyControllableLive::~QNetworkReplyControllableLive()
 void QNetworkReplyControllableLive::slFinished()
 {
     // this is always handled by the main thread, Qt signal magic
+
+    if (m_factory->chunkCoalescing() != QNetworkReplyControllableFactory::NO_COALESCING) {
+        // Expose data left over from coalescing in a last readyRead, the finished signal itself does not forward data
+        m_initialSnapshot->appendData(m_reply);
+
+        if (m_initialSnapshot->bytesNotInSnapshot() > 0) {
+            enqueueSnapshot(QNetworkReplyInitialSnapshot::READY_READ,
+                            m_initialSnapshot->takeSnapshot(QNetworkReplyInitialSnapshot::READY_READ, m_reply));
+        }
+    }
+
     enqueueSnapshot(QNetworkReplyInitialSnapshot::FINISHED,
                     m_initialSnapshot->takeSnapshot(QNetworkReplyInitialSnapshot::FINISHED, m_reply));
+
+    m_factory->controllableFinished(this);
 }
 
 void QNetworkReplyControllableLive::slReadyRead()
 {
     // this is always handled by the main thread, Qt signal magic
-    enqueueSnapshot(QNetworkReplyInitialSnapshot::READY_READ,
-                    m_initialSnapshot->takeSnapshot(QNetworkReplyInitialSnapshot::READY_READ, m_reply));
+
+    if (m_factory->chunkCoalescing() == QNetworkReplyControllableFactory::NO_COALESCING) {
+        enqueueSnapshot(QNetworkReplyInitialSnapshot::READY_READ,
+                        m_initialSnapshot->takeSnapshot(QNetworkReplyInitialSnapshot::READY_READ, m_reply));
+        return;
+    }
+
+    // Only expose data at chunk boundaries, such that the number of network event actions does not depend on
+    // how the OS happens to buffer the socket
+
+    m_initialSnapshot->appendData(m_reply);
+
+    bool tokens = m_factory->chunkCoalescing() == QNetworkReplyControllableFactory::TOKEN_COALESCING;
+
+    qint64 boundary;
+    while ((boundary = m_initialSnapshot->nextChunkBoundary(m_factory->chunkSize(), tokens)) != -1) {
+        enqueueSnapshot(QNetworkReplyInitialSnapshot::READY_READ,
+                        m_initialSnapshot->takeSnapshot(QNetworkReplyInitialSnapshot::READY_READ, m_reply, boundary));
+    }
 }
 
 void QNetworkReplyControllableLive::detachFromReply()
@@ -557,6 +661,9 @@ void QNetworkReplyControllableFactory::setFactory(QNetworkReplyControllableFacto
 
 QNetworkReplyControllableFactory::QNetworkReplyControllableFactory()
     : m_doneCounter(0)
+    , m_chunkCoalescing(NO_COALESCING)
+    , m_chunkSize(0)
+    , m_spillFile(new QNetworkReplySpillFile())
 {
 }
 
@@ -567,11 +674,18 @@ QNetworkReplyControllableFactory::~QNetworkReplyControllableFactory()
 void QNetworkReplyControllableFactory::controllableDone(QNetworkReplyControllable* controllable)
 {
     m_doneCounter++;
+    m_openNetworkSessions.erase(controllable);
 }
 
 void QNetworkReplyControllableFactory::controllableConstructed(QNetworkReplyControllable* controllable)
 {
     m_networkHistory.push_back(controllable->initialSnapshot());
+    m_openNetworkSessions.insert(controllable);
+}
+
+void QNetworkReplyControllableFactory::controllableFinished(QNetworkReplyControllable* controllable)
+{
+    m_openNetworkSessions.erase(controllable);
 }
 
 void QNetworkReplyControllableFactory::writeNetworkFile(QString networkFilePath)
@@ -996,17 +1110,32 @@ void QNetworkReplyHandler::forwardData()
 {
     ASSERT(m_replyWrapper && m_replyWrapper->reply() && !wasAborted() && !m_replyWrapper->wasRedirected());
 
-    QByteArray data = m_replyWrapper->reply()->snapshot()->read(m_replyWrapper->reply()->snapshot()->bytesAvailable());
+    // WebERA: Mapped segments of the snapshot body store are forwarded without copying, see QNetworkReplySnapshotBody
+    QNetworkReplySnapshot* snapshot = m_replyWrapper->reply()->snapshot();
+    qint64 available = snapshot->bytesAvailable();
 
-    ResourceHandleClient* client = m_resourceHandle->client();
-    if (!client)
-        return;
+    while (available > 0) {
+        const char* data = 0;
+        QByteArray buffer;
+        qint64 length = snapshot->readData(available, &data, &buffer);
+        if (length <= 0)
+            return;
 
-    // FIXME: https://bugs.webkit.org/show_bug.cgi?id=19793
-    // -1 means we do not provide any data about transfer size to inspector so it would use
-    // Content-Length headers or content size to show transfer size.
-    if (!data.isEmpty())
-        client->didReceiveData(m_resourceHandle, data.constData(), data.length(), -1);
+        available -= length;
+
+        ResourceHandleClient* client = m_resourceHandle->client();
+        if (!client)
+            continue;
+
+        // FIXME: https://bugs.webkit.org/show_bug.cgi?id=19793
+        // -1 means we do not provide any data about transfer size to inspector so it would use
+        // Content-Length headers or content size to show transfer size.
+        client->didReceiveData(m_resourceHandle, data, length, -1);
+
+        // The client may cancel the load
+        if (wasAborted())
+            return;
+    }
 }
 
 void QNetworkReplyHandler::uploadProgress(qint64 bytesSent, qint64 bytesTotal)
@@ -37,6 +37,7 @@
 
 #include "WebCore/platform/network/FormData.h"
 #include "QtMIMETypeSniffer.h"
+#include "QNetworkReplySnapshotBody.h"
 
 #include <QNetworkReply>
 
@@ -124,11 +125,26 @@ public:
         END
     };
 
-    QNetworkReplyInitialSnapshot(QNetworkReply* reply);
+    // Large bodies are spilled to spillFile (see QNetworkReplySnapshotBody::setSpillFile)
+    QNetworkReplyInitialSnapshot(QNetworkReply* reply, const QSharedPointer<QNetworkReplySpillFile>& spillFile);
     ~QNetworkReplyInitialSnapshot();
 
     QNetworkReplySnapshot* takeSnapshot(NetworkSignal signal, QNetworkReply* reply);
 
+    // Reads pending data from the reply without taking a snapshot
+    void appendData(QNetworkReply* reply);
+
+    // Takes a snapshot exposing the stream up to (excluding) streamSize
+    QNetworkReplySnapshot* takeSnapshot(NetworkSignal signal, QNetworkReply* reply, qint64 streamSize);
+
+    // Number of bytes read from the reply, but not exposed by any snapshot
+    qint64 bytesNotInSnapshot() const;
+
+    // Next deterministic chunk boundary after the last snapshot, or -1 if not enough data has been read yet.
+    // Boundaries are placed every chunkSize bytes, or at the first '>' or newline after chunkSize bytes if tokens is set
+    // (at 2 * chunkSize bytes if there is none before).
+    qint64 nextChunkBoundary(qint64 chunkSize, bool tokens);
+
     unsigned int getSameUrlSequenceNumber() {
         return m_sameUrlSequenceNumber;
     }
@@ -149,9 +165,12 @@ public:
     }
 
     void serialize(QIODevice* stream) const;
-    static QNetworkReplyInitialSnapshot* deserialize(QIODevice* stream);
+    // If memory is set it backs the stream, and response bodies reference it directly (it must outlive the snapshot)
+    static QNetworkReplyInitialSnapshot* deserialize(QIODevice* stream, const char* memory = 0);
 
     static unsigned int getNextSameUrlSequenceNumber(const QUrl& url);
+    // Called when a new page is loaded.
+    static void resetSameUrlSequenceNumbers();
 
 protected:
 
@@ -162,6 +181,7 @@ protected:
 
     QByteArray read(qint64 maxlen);
     QByteArray peek(qint64 maxlen);
+    qint64 readData(qint64 maxlen, const char** data, QByteArray* buffer);
 
     QList<QNetworkReply::RawHeaderPair> m_headers;
     QVariant m_cookies;
@@ -170,13 +190,10 @@ protected:
     QUrl m_url;
 
     qint64 m_streamPosition; // points at the next value to read
-    QByteArray m_stream;
+    QNetworkReplySnapshotBody m_stream;
+    qint64 m_tokenScanPosition; // data before it was searched for a chunk boundary token (see nextChunkBoundary)
 
     QList<QNetworkReplySnapshotEntry> m_snapshots;
-
-private:
-    static QHash<QString, unsigned int> m_nextSameUrlSequenceNumber;
-
 };
 
 class QNetworkReplySnapshot
@@ -222,6 +239,12 @@ public:
         return m_base->peek(std::min(bytesAvailable(), maxlen));
     }
 
+    // Reads the mapped bytes at the current position without copying (possibly fewer than maxlen), or copies the
+    // data into buffer if it is not mapped
+    qint64 readData(qint64 maxlen, const char** data, QByteArray* buffer) {
+        return m_base->readData(std::min(bytesAvailable(), maxlen), data, buffer);
+    }
+
 private:
     QNetworkReplyInitialSnapshot* m_base;
 
@@ -332,12 +355,36 @@ public:
 
     void controllableDone(QNetworkReplyControllable* controllable);
     void controllableConstructed(QNetworkReplyControllable* controllable);
+    void controllableFinished(QNetworkReplyControllable* controllable);
     void writeNetworkFile(QString networkFilePath);
 
+    enum ChunkCoalescing {
+        NO_COALESCING,
+        SIZE_COALESCING,  // A network event action for every chunkSize bytes
+        TOKEN_COALESCING  // A network event action at the first '>' or newline after chunkSize bytes (at most 2 * chunkSize bytes)
+    };
+
+    // Coalesce readyRead signals from the network into deterministic chunks
+    void setChunkCoalescing(ChunkCoalescing mode, qint64 chunkSize) {
+        m_chunkCoalescing = chunkSize > 0 ? mode : NO_COALESCING;
+        m_chunkSize = chunkSize;
+    }
+
+    ChunkCoalescing chunkCoalescing() const { return m_chunkCoalescing; }
+    qint64 chunkSize() const { return m_chunkSize; }
+
+    // Shared by the response bodies of this factory, see QNetworkReplySnapshotBody
+    const QSharedPointer<QNetworkReplySpillFile>& spillFile() const { return m_spillFile; }
+
     unsigned int doneCounter() const {
         return m_doneCounter;
     }
 
+    // Number of network requests still waiting for data from the network
+    unsigned int numOpenNetworkSessions() const {
+        return m_openNetworkSessions.size();
+    }
+
     static QNetworkReplyControllableFactory* getFactory();
     static void setFactory(QNetworkReplyControllableFactory* factory);
 
@@ -348,6 +395,11 @@ private:
     unsigned int m_doneCounter;
     std::list<WebCore::QNetworkReplyInitialSnapshot*> m_networkHistory;
 
+    ChunkCoalescing m_chunkCoalescing;
+    qint64 m_chunkSize;
+
+    QSharedPointer<QNetworkReplySpillFile> m_spillFile;
+
     static QNetworkReplyControllableFactory* m_factory;
 };
 
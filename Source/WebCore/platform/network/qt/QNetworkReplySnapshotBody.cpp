@@ -0,0 +1,359 @@
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#include "config.h"
+#include "QNetworkReplySnapshotBody.h"
+
+#include <algorithm>
+#include <string.h>
+
+#include <QDir>
+#include <QHash>
+#include <QTemporaryFile>
+#include <QWeakPointer>
+
+#include <wtf/Assertions.h>
+#include <wtf/FastMalloc.h>
+
+namespace WebCore
+{
+
+QNetworkReplySpillFile::QNetworkReplySpillFile()
+    : m_file(QDir::tempPath() + "/webera-body-XXXXXX")
+    , m_end(0)
+{
+}
+
+const char* QNetworkReplySpillFile::spill(const char* data, qint64 size)
+{
+    if (!m_file.isOpen() && !m_file.open()) {
+        return 0;
+    }
+
+    qint64 offset = m_end;
+    bool reused = false;
+
+    QMultiHash<qint64, qint64>::iterator released = m_free.find(size);
+    if (released != m_free.end()) {
+        offset = released.value();
+        m_free.erase(released);
+        reused = true;
+    }
+
+    uchar* mapped = 0;
+
+    if (m_file.seek(offset) && m_file.write(data, size) == size) {
+        m_file.flush();
+        mapped = m_file.map(offset, size);
+    }
+
+    if (!mapped) {
+        if (reused) {
+            m_free.insert(size, offset);
+        }
+        return 0;
+    }
+
+    if (!reused) {
+        m_end += size;
+    }
+
+    m_offsets.insert(reinterpret_cast<const char*>(mapped), offset);
+    return reinterpret_cast<const char*>(mapped);
+}
+
+void QNetworkReplySpillFile::release(const char* mapped, qint64 size)
+{
+    ASSERT(m_offsets.contains(mapped));
+
+    m_file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(mapped)));
+    m_free.insert(size, m_offsets.take(mapped));
+}
+
+qint64 QNetworkReplySnapshotBody::s_segmentSize = 1024 * 1024; // 1 MB
+
+QNetworkReplySnapshotBody::QNetworkReplySnapshotBody()
+    : m_segmentSize(s_segmentSize)
+    , m_external(0)
+    , m_externalSize(0)
+{
+}
+
+QNetworkReplySnapshotBody::~QNetworkReplySnapshotBody()
+{
+    for (size_t i = 0; i < m_segments.size(); ++i) {
+        if (m_segmentOnHeap[i]) {
+            fastFree(const_cast<char*>(m_segments[i]));
+        } else {
+            m_spillFile->release(m_segments[i], m_segmentSize);
+        }
+    }
+
+    if (m_external && m_file) {
+        m_file->unmap(reinterpret_cast<uchar*>(const_cast<char*>(m_external)));
+    }
+}
+
+void QNetworkReplySnapshotBody::setSegmentSize(qint64 size)
+{
+    ASSERT(size > 0);
+    s_segmentSize = size;
+}
+
+void QNetworkReplySnapshotBody::setSpillFile(const QSharedPointer<QNetworkReplySpillFile>& spillFile)
+{
+    ASSERT(m_segments.isEmpty());
+    m_spillFile = spillFile;
+}
+
+void QNetworkReplySnapshotBody::append(const QByteArray& data)
+{
+    ASSERT(!m_external); // bodies mapped from a network log are read only
+
+    const char* source = data.constData();
+    qint64 remaining = data.size();
+
+    while (remaining > 0) {
+        qint64 length = std::min(remaining, m_segmentSize - (qint64)m_tail.size());
+
+        m_tail.append(source, length);
+        source += length;
+        remaining -= length;
+
+        if ((qint64)m_tail.size() == m_segmentSize) {
+            spillTail();
+        }
+    }
+}
+
+qint64 QNetworkReplySnapshotBody::size() const
+{
+    if (m_external) {
+        return m_externalSize;
+    }
+
+    return m_segments.size() * m_segmentSize + m_tail.size();
+}
+
+qint64 QNetworkReplySnapshotBody::region(qint64 position, qint64 maxlen, const char** data) const
+{
+    *data = 0;
+
+    if (position < 0 || position >= size() || maxlen <= 0) {
+        return 0;
+    }
+
+    if (m_external) {
+        *data = m_external + position;
+        return std::min(maxlen, m_externalSize - position);
+    }
+
+    size_t segment = position / m_segmentSize;
+    qint64 offset = position - segment * m_segmentSize;
+
+    if (segment < m_segments.size()) {
+        *data = m_segments[segment] + offset;
+        return std::min(maxlen, m_segmentSize - offset);
+    }
+
+    *data = m_tail.data() + offset;
+    return std::min(maxlen, (qint64)m_tail.size() - offset);
+}
+
+qint64 QNetworkReplySnapshotBody::mappedData(qint64 position, qint64 maxlen, const char** data) const
+{
+    if (!m_external && position >= (qint64)m_segments.size() * m_segmentSize) {
+        *data = 0;
+        return 0; // in-memory window, may move on the next append
+    }
+
+    return region(position, maxlen, data);
+}
+
+QByteArray QNetworkReplySnapshotBody::copy(qint64 position, qint64 maxlen) const
+{
+    QByteArray result;
+    result.reserve(std::max((qint64)0, std::min(maxlen, size() - position)));
+
+    while (maxlen > 0) {
+        const char* data;
+        qint64 length = region(position, maxlen, &data);
+
+        if (length == 0) {
+            break;
+        }
+
+        result.append(data, length);
+        position += length;
+        maxlen -= length;
+    }
+
+    return result;
+}
+
+qint64 QNetworkReplySnapshotBody::indexOfAny(qint64 position, qint64 end, const char* chars) const
+{
+    end = std::min(end, size());
+
+    while (position < end) {
+        const char* data;
+        qint64 length = region(position, end - position, &data);
+
+        if (length == 0) {
+            return -1;
+        }
+
+        for (qint64 i = 0; i < length; ++i) {
+            if (strchr(chars, data[i]) && data[i] != '\0') {
+                return position + i;
+            }
+        }
+
+        position += length;
+    }
+
+    return -1;
+}
+
+void QNetworkReplySnapshotBody::serialize(QDataStream& out) const
+{
+    // Same format as QDataStream << QByteArray
+
+    out << (quint32)size();
+
+    qint64 position = 0;
+    while (true) {
+        const char* data;
+        qint64 length = region(position, size() - position, &data);
+
+        if (length == 0) {
+            break;
+        }
+
+        out.writeRawData(data, length);
+        position += length;
+    }
+}
+
+void QNetworkReplySnapshotBody::deserialize(QDataStream& in, const char* memory)
+{
+    ASSERT(size() == 0);
+
+    quint32 length;
+    in >> length;
+
+    if (length == 0xFFFFFFFF || length == 0) {
+        return; // null or empty QByteArray
+    }
+
+    if (memory) {
+        m_external = memory + in.device()->pos();
+        m_externalSize = length;
+
+        in.skipRawData(length);
+        return;
+    }
+
+    // Large bodies are mapped directly from the network log
+
+    QFile* file = qobject_cast<QFile*>(in.device());
+
+    if (file && (qint64)length > m_segmentSize && !file->fileName().isEmpty()) {
+        QSharedPointer<QFile> shared = sharedFile(file->fileName());
+        uchar* mapped = shared ? shared->map(file->pos(), length) : 0;
+
+        if (mapped) {
+            m_file = shared;
+            m_external = reinterpret_cast<const char*>(mapped);
+            m_externalSize = length;
+
+            in.skipRawData(length);
+            return;
+        }
+    }
+
+    readTail(in, length);
+}
+
+void QNetworkReplySnapshotBody::readTail(QDataStream& in, qint64 length)
+{
+    while (length > 0 && in.status() == QDataStream::Ok) {
+        size_t offset = m_tail.size();
+        qint64 chunk = std::min(length, m_segmentSize - (qint64)offset);
+
+        m_tail.grow(offset + chunk);
+        int read = in.readRawData(m_tail.data() + offset, chunk);
+
+        if (read != chunk) {
+            m_tail.shrink(offset + std::max(read, 0));
+            in.setStatus(QDataStream::ReadPastEnd);
+            return;
+        }
+
+        length -= chunk;
+
+        if ((qint64)m_tail.size() == m_segmentSize) {
+            spillTail();
+        }
+    }
+}
+
+void QNetworkReplySnapshotBody::spillTail()
+{
+    ASSERT((qint64)m_tail.size() == m_segmentSize);
+
+    if (!m_spillFile) {
+        m_spillFile = QSharedPointer<QNetworkReplySpillFile>(new QNetworkReplySpillFile());
+    }
+
+    const char* mapped = m_spillFile->spill(m_tail.data(), m_segmentSize);
+
+    if (mapped) {
+        m_segments.append(mapped);
+        m_segmentOnHeap.append(false);
+    } else {
+        // Could not spill, keep the segment in memory
+        char* segment = static_cast<char*>(fastMalloc(m_segmentSize));
+        memcpy(segment, m_tail.data(), m_segmentSize);
+
+        m_segments.append(segment);
+        m_segmentOnHeap.append(true);
+    }
+
+    m_tail.shrink(0);
+}
+
+QSharedPointer<QFile> QNetworkReplySnapshotBody::sharedFile(const QString& path)
+{
+    static QHash<QString, QWeakPointer<QFile> > files;
+
+    QSharedPointer<QFile> file = files.value(path).toStrongRef();
+
+    if (!file) {
+        file = QSharedPointer<QFile>(new QFile(path));
+
+        if (!file->open(QIODevice::ReadOnly)) {
+            return QSharedPointer<QFile>();
+        }
+
+        files.insert(path, file.toWeakRef());
+    }
+
+    return file;
+}
+
+}
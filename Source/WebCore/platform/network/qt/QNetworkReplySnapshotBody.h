@@ -0,0 +1,133 @@
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifndef QNETWORKREPLYSNAPSHOTBODY_H
+#define QNETWORKREPLYSNAPSHOTBODY_H
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QHash>
+#include <QSharedPointer>
+#include <QTemporaryFile>
+
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace WebCore
+{
+
+/**
+ * WebERA:
+ *
+ * Temporary file holding the spilled segments of many bodies, such that they share a single file descriptor.
+ * The region of a released segment is reused by a later segment of the same size.
+ */
+class QNetworkReplySpillFile {
+    WTF_MAKE_NONCOPYABLE(QNetworkReplySpillFile);
+
+public:
+    QNetworkReplySpillFile();
+
+    // Writes size bytes to the file and maps them, returns 0 if they could not be spilled
+    const char* spill(const char* data, qint64 size);
+    // Unmaps a region returned by spill()
+    void release(const char* mapped, qint64 size);
+
+private:
+    QTemporaryFile m_file;
+    qint64 m_end;
+
+    QHash<const char*, qint64> m_offsets; // mapped region -> offset in the file
+    QMultiHash<qint64, qint64> m_free; // size -> offset of a released region
+};
+
+/**
+ * WebERA:
+ *
+ * Append-only store for the body of a network response.
+ *
+ * The body is kept in memory until it exceeds one segment. Complete segments are spilled to a temporary
+ * file and mapped into memory, such that only the (partial) last segment is kept on the heap. In replay the
+ * body is mapped directly from the network log file, or referenced in shared memory, instead of being read into memory.
+ *
+ * mappedData() returns a pointer into a mapped region without copying, the pointer is valid for the lifetime of the store.
+ * While recording, data is read soon after it is appended, mostly from the in-memory window, and has to be copied.
+ * Only the part of a read in a segment spilled meanwhile is mapped.
+ *
+ * The serialized form is identical to a serialized QByteArray, and can be read as such.
+ */
+class QNetworkReplySnapshotBody {
+    WTF_MAKE_NONCOPYABLE(QNetworkReplySnapshotBody);
+
+public:
+    QNetworkReplySnapshotBody();
+    ~QNetworkReplySnapshotBody();
+
+    // The file complete segments are spilled to, shared with other bodies. A body without one creates its own
+    // when it first spills.
+    void setSpillFile(const QSharedPointer<QNetworkReplySpillFile>& spillFile);
+
+    void append(const QByteArray& data);
+
+    qint64 size() const;
+
+    // Sets *data to the mapped bytes at position, and returns the number of contiguous bytes available there
+    // (at most maxlen). Returns 0 if position is not mapped, e.g. if it is in the in-memory window.
+    qint64 mappedData(qint64 position, qint64 maxlen, const char** data) const;
+
+    // Copies up to maxlen bytes at position
+    QByteArray copy(qint64 position, qint64 maxlen) const;
+
+    // Position of the first byte in [position, end) which is one of the (nul terminated) chars, or -1
+    qint64 indexOfAny(qint64 position, qint64 end, const char* chars) const;
+
+    void serialize(QDataStream& out) const;
+
+    // If memory is set it is the memory backing the device of in, and it must outlive the body. The body then
+    // references the memory directly instead of copying it.
+    void deserialize(QDataStream& in, const char* memory = 0);
+
+    // Size of the in-memory window, and of each spilled segment (a multiple of the page size)
+    static void setSegmentSize(qint64 size);
+
+private:
+    qint64 region(qint64 position, qint64 maxlen, const char** data) const;
+
+    void spillTail();
+    void readTail(QDataStream& in, qint64 length);
+
+    static QSharedPointer<QFile> sharedFile(const QString& path);
+
+    QSharedPointer<QFile> m_file; // the network log file m_external is mapped from
+    QSharedPointer<QNetworkReplySpillFile> m_spillFile;
+
+    WTF::Vector<const char*> m_segments;
+    WTF::Vector<bool> m_segmentOnHeap; // could not be mapped
+    qint64 m_segmentSize;
+
+    const char* m_external; // the complete body, mapped from a network log file or in memory owned by someone else
+    qint64 m_externalSize;
+
+    WTF::Vector<char> m_tail;
+
+    static qint64 s_segmentSize;
+};
+
+}
+
+#endif // QNETWORKREPLYSNAPSHOTBODY_H
@@ -0,0 +1,197 @@
+/*
+ * EventActionProfiler.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "EventActionProfiler.h"
+
+#include <fstream>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <wtf/ActionLogReport.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/LittleEndianIO.h>
+
+namespace WebCore {
+
+// Binary profile trace: magic, version, number of records and number of dropped records, followed by the records.
+// All integers are little endian, times are in microseconds.
+static const char binaryMagic[4] = { 'E', 'R', 'P', 'T' };
+static const uint32_t binaryVersion = 1;
+static const uint32_t unknownLatency = 0xFFFFFFFF;
+
+static void writeString(std::ostream& out, const std::string& value)
+{
+    writeUInt32(out, value.length());
+    out.write(value.data(), value.length());
+}
+
+static uint64_t toMicroseconds(double seconds)
+{
+    return seconds <= 0 ? 0 : (uint64_t)(seconds * 1000000.0);
+}
+
+static void writeJSONString(std::ostream& out, const std::string& value)
+{
+    out << '"';
+    for (std::string::const_iterator it = value.begin(); it != value.end(); ++it) {
+        unsigned char c = *it;
+        switch (c) {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if (c < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out << escaped;
+            } else {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+}
+
+static const char* categoryName(WTF::EventActionCategory category)
+{
+    switch (category) {
+    case WTF::TIMER:
+        return "timer";
+    case WTF::USER_INTERFACE:
+        return "user-interface";
+    case WTF::NETWORK:
+        return "network";
+    case WTF::PARSING:
+        return "parsing";
+    case WTF::OTHER:
+    default:
+        return "other";
+    }
+}
+
+EventActionProfiler::EventActionProfiler(size_t capacity)
+    : m_records(capacity > 0 ? capacity : 1)
+    , m_first(0)
+    , m_size(0)
+    , m_dropped(0)
+    , m_epoch(WTF::monotonicallyIncreasingTime())
+    , m_currentStart(0)
+    , m_currentRegisteredAt(-1)
+    , m_currentInternedBytes(0)
+{
+}
+
+void EventActionProfiler::enterEventAction(double registeredAt)
+{
+    m_currentRegisteredAt = registeredAt;
+    m_currentInternedBytes = ActionLogInternedBytes();
+    m_currentStart = WTF::monotonicallyIncreasingTime();
+}
+
+void EventActionProfiler::exitEventAction(WTF::EventActionId id, const WTF::EventActionDescriptor& descriptor, bool commit)
+{
+    double end = WTF::monotonicallyIncreasingTime();
+
+    if (!commit) {
+        return;
+    }
+
+    Record* record;
+    if (m_size < m_records.size()) {
+        record = &m_records[(m_first + m_size) % m_records.size()];
+        m_size++;
+    } else {
+        // Full, overwrite the oldest record
+        record = &m_records[m_first];
+        m_first = (m_first + 1) % m_records.size();
+        m_dropped++;
+    }
+
+    record->id = id;
+    record->category = descriptor.getCategory();
+    record->type = descriptor.getType();
+    record->params = descriptor.getParams();
+    record->start = m_currentStart - m_epoch;
+    record->duration = end - m_currentStart;
+    record->queueLatency = m_currentRegisteredAt < 0 ? -1 : m_currentStart - m_currentRegisteredAt;
+    record->commands = ActionLogEventActionCommandCount(id);
+    record->internedBytes = ActionLogInternedBytes() - m_currentInternedBytes;
+}
+
+bool EventActionProfiler::writeChromeTrace(const std::string& path) const
+{
+    std::ofstream out(path.c_str());
+    if (!out.is_open()) {
+        return false;
+    }
+
+    out << "{\"traceEvents\":[";
+
+    for (size_t i = 0; i < m_size; ++i) {
+        const Record& record = at(i);
+
+        out << (i == 0 ? "\n" : ",\n");
+        out << "{\"ph\":\"X\",\"pid\":1,\"tid\":1"
+            << ",\"ts\":" << toMicroseconds(record.start)
+            << ",\"dur\":" << toMicroseconds(record.duration)
+            << ",\"cat\":\"" << categoryName(record.category) << "\""
+            << ",\"name\":";
+        writeJSONString(out, record.type);
+        out << ",\"args\":{\"id\":" << record.id << ",\"params\":";
+        writeJSONString(out, record.params);
+        if (record.queueLatency >= 0) {
+            out << ",\"queueLatency\":" << toMicroseconds(record.queueLatency);
+        }
+        out << ",\"commands\":" << record.commands
+            << ",\"internedBytes\":" << record.internedBytes
+            << "}}";
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":" << m_dropped << "}}" << std::endl;
+
+    return out.good();
+}
+
+bool EventActionProfiler::writeBinary(const std::string& path) const
+{
+    std::ofstream out(path.c_str(), std::ios_base::binary);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    out.write(binaryMagic, sizeof(binaryMagic));
+    writeUInt32(out, binaryVersion);
+    writeUInt32(out, m_size);
+    writeUInt32(out, m_dropped);
+
+    for (size_t i = 0; i < m_size; ++i) {
+        const Record& record = at(i);
+
+        writeUInt32(out, record.id);
+        writeUInt32(out, record.category);
+        writeUInt64(out, toMicroseconds(record.start));
+        writeUInt32(out, toMicroseconds(record.duration));
+        writeUInt32(out, record.queueLatency < 0 ? unknownLatency : toMicroseconds(record.queueLatency));
+        writeUInt32(out, record.commands);
+        writeUInt32(out, record.internedBytes);
+        writeString(out, record.type);
+        writeString(out, record.params);
+    }
+
+    return out.good();
+}
+
+}  // namespace WebCore
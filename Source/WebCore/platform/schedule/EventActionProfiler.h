@@ -0,0 +1,82 @@
+/*
+ * EventActionProfiler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef EVENTACTIONPROFILER_H_
+#define EVENTACTIONPROFILER_H_
+
+#include <string>
+#include <vector>
+
+#include <wtf/Noncopyable.h>
+
+#include "wtf/EventActionDescriptor.h"
+
+namespace WebCore {
+
+/**
+ * WebERA:
+ *
+ * Per event action profiling trace.
+ *
+ * For each committed event action the profiler records when it started (monotonic time), how long it ran,
+ * how long it waited between being registered and being dispatched (queue latency), how many commands it
+ * added to the action log and how many bytes it interned in the action log string sets.
+ *
+ * Records are kept in a fixed size ring buffer, such that profiling long explorations has a bounded cost.
+ * If the buffer overflows the oldest records are dropped.
+ *
+ * The trace can be written as Chrome trace JSON (load it in chrome://tracing) or as a compact binary file.
+ *
+ */
+class EventActionProfiler {
+    WTF_MAKE_NONCOPYABLE(EventActionProfiler);
+
+public:
+    explicit EventActionProfiler(size_t capacity = 65536);
+
+    // registeredAt is the time the event action was registered, or -1 if unknown
+    void enterEventAction(double registeredAt);
+    void exitEventAction(WTF::EventActionId id, const WTF::EventActionDescriptor& descriptor, bool commit);
+
+    size_t size() const { return m_size; }
+    unsigned long dropped() const { return m_dropped; }
+
+    bool writeChromeTrace(const std::string& path) const;
+    bool writeBinary(const std::string& path) const;
+
+private:
+    struct Record {
+        WTF::EventActionId id;
+        WTF::EventActionCategory category;
+        std::string type;
+        std::string params;
+
+        double start; // seconds since the profiler was created
+        double duration; // seconds
+        double queueLatency; // seconds, -1 if unknown
+
+        unsigned int commands;
+        unsigned int internedBytes;
+    };
+
+    const Record& at(size_t index) const { return m_records[(m_first + index) % m_records.size()]; }
+
+    std::vector<Record> m_records;
+    size_t m_first;
+    size_t m_size;
+    unsigned long m_dropped;
+
+    double m_epoch;
+
+    double m_currentStart;
+    double m_currentRegisteredAt;
+    size_t m_currentInternedBytes;
+};
+
+}  // namespace WebCore
+
+#endif /* EVENTACTIONPROFILER_H_ */
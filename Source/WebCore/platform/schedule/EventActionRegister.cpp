@@ -19,14 +19,27 @@
 
 #include <WebCore/platform/EventActionHappensBeforeReport.h>
 #include <wtf/ActionLogReport.h>
+#include <wtf/CurrentTime.h>
 
 namespace WebCore {
 
 struct EventActionHandler {
     void* object; // some event handler specific payload
     EventActionHandlerFunction function;
+    double registeredAt; // monotonic time of registration, -1 for providers
 
-    EventActionHandler(EventActionHandlerFunction function, void* object)
+    EventActionHandler(EventActionHandlerFunction function, void* object, double registeredAt = -1)
+        : object(object)
+        , function(function)
+        , registeredAt(registeredAt)
+    {}
+};
+
+struct EventActionObserver {
+    void* object;
+    EventActionObserverFunction function;
+
+    EventActionObserver(EventActionObserverFunction function, void* object)
         : object(object)
         , function(function)
     {}
@@ -46,19 +59,36 @@ public:
 
     typedef std::set<std::string> DescriptorSet;
     DescriptorSet m_currentDescriptors; // keys in m_descriptorToHandler
+
+    typedef std::vector<EventActionObserver> ObserverVector;
+    ObserverVector m_observers;
 };
 
 EventActionRegister::EventActionRegister()
     : m_maps(new EventActionRegisterMaps)
     , m_isDispatching(false)
-    , m_dispatchHistory(new EventActionSchedule())
+    , m_dispatchHistory(new EventActionScheduleWriter())
     , m_verbose(false)
+    , m_profiler(0)
 {
 }
 
 EventActionRegister::~EventActionRegister() {
 	delete m_maps;
     delete m_dispatchHistory;
+    delete m_profiler;
+}
+
+void EventActionRegister::setProfiling(bool enabled)
+{
+    ASSERT(!m_isDispatching);
+
+    if (enabled && !m_profiler) {
+        m_profiler = new EventActionProfiler();
+    } else if (!enabled) {
+        delete m_profiler;
+        m_profiler = 0;
+    }
 }
 
 void EventActionRegister::registerEventActionProvider(const std::string& type, EventActionHandlerFunction f, void* object)
@@ -71,7 +101,7 @@ void EventActionRegister::registerEventActionHandler(const WTF::EventActionDescr
 {
     std::string key = descriptor.toString();
 
-    EventActionHandler target(f, object);
+    EventActionHandler target(f, object, m_profiler ? WTF::monotonicallyIncreasingTime() : -1);
     m_maps->m_descriptorToHandler[key].push(target);
     m_maps->m_currentDescriptors.insert(key);
 }
@@ -88,6 +118,19 @@ void EventActionRegister::deregisterEventActionHandler(const WTF::EventActionDes
     m_maps->m_currentDescriptors.erase(key);
 }
 
+void EventActionRegister::registerEventActionObserver(EventActionObserverFunction f, void* object)
+{
+    m_maps->m_observers.push_back(EventActionObserver(f, object));
+}
+
+void EventActionRegister::notifyEventActionObservers(WTF::EventActionId id, const WTF::EventActionDescriptor& descriptor)
+{
+    EventActionRegisterMaps::ObserverVector::const_iterator it = m_maps->m_observers.begin();
+    for (; it != m_maps->m_observers.end(); it++) {
+        (it->function)(it->object, id, descriptor);
+    }
+}
+
 bool EventActionRegister::runEventAction(const WTF::EventActionDescriptor& descriptor) {
         runEventAction(-1, -1, descriptor);
 }
@@ -147,7 +190,7 @@ bool EventActionRegister::runEventAction(WTF::EventActionId newEventActionId, WT
 
     WTF::EventActionId id = newEventActionId == -1 ? HBAllocateEventActionId() : newEventActionId;
 
-    eventActionDispatchStart(id, originalEventActionId, descriptor);
+    eventActionDispatchStart(id, originalEventActionId, descriptor, l.front().registeredAt);
     HBEnterEventAction(id, toActionLogType(descriptor.getCategory()));
     ActionLogEventTriggered(l.front().object);
 
@@ -231,4 +274,9 @@ std::set<std::string> EventActionRegister::getWaitingNames()
     return m_maps->m_currentDescriptors;
 }
 
+bool EventActionRegister::hasWaitingEventActions() const
+{
+    return !m_maps->m_currentDescriptors.empty();
+}
+
 }  // namespace WebCore
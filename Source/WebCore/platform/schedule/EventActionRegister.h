@@ -17,9 +17,12 @@
 
 #include "wtf/ActionLogReport.h"
 
+#include "EventActionProfiler.h"
+
 namespace WebCore {
 
 typedef bool (*EventActionHandlerFunction)(void* object, const WTF::EventActionDescriptor& descriptor);
+typedef void (*EventActionObserverFunction)(void* object, WTF::EventActionId id, const WTF::EventActionDescriptor& descriptor);
 
 class EventActionRegisterMaps;
 
@@ -50,6 +53,9 @@ public:
     void registerEventActionHandler(const WTF::EventActionDescriptor& descriptor, EventActionHandlerFunction f, void* object);
     void deregisterEventActionHandler(const WTF::EventActionDescriptor& descriptor);
 
+    // Observers are notified after each committed (executed) event action
+    void registerEventActionObserver(EventActionObserverFunction f, void* object);
+
     // Attempts to execute an event action. Returns true on success.
     bool runEventAction(const WTF::EventActionDescriptor& descriptor);
     bool runEventAction(WTF::EventActionId newEventActionId, WTF::EventActionId originalEventActionId, const WTF::EventActionDescriptor& descriptor);
@@ -70,15 +76,17 @@ public:
     const WTF::EventActionDescriptor& currentEventActionDispatching() const
     {
         if (m_isDispatching) {
-            return m_dispatchHistory->isEmpty() ? WTF::EventActionDescriptor::null : m_dispatchHistory->last().second;
+            return m_dispatching.second;
         }
 
         return WTF::EventActionDescriptor::null;
     }
 
-    EventActionSchedule* dispatchHistory() { return m_dispatchHistory; }
+    // Committed event actions are streamed to disk, see EventActionScheduleWriter
+    EventActionScheduleWriter* dispatchHistory() { return m_dispatchHistory; }
 
     std::set<std::string> getWaitingNames();
+    bool hasWaitingEventActions() const;
 
     void debugPrintNames(std::ostream& out) const;
 
@@ -111,6 +119,15 @@ public:
         m_verbose = v;
     }
 
+    // Records a profiling trace of each committed event action, see EventActionProfiler
+    void setProfiling(bool enabled);
+    EventActionProfiler* profiler() { return m_profiler; }
+
+    // The id of each dispatched event action in the schedule that was replayed, mapped to its id in this run
+    const std::map<int, int>& originalToNewEventActionIds() const {
+        return m_originalToNewEventActionIdMap;
+    }
+
     WTF::EventActionId translateOldIdToNew(WTF::EventActionId oldId) {
         std::map<int, int>::const_iterator it = m_originalToNewEventActionIdMap.find(oldId);
 
@@ -123,14 +140,18 @@ public:
 
 private:
 
-    void eventActionDispatchStart(WTF::EventActionId id, WTF::EventActionId originalId, const WTF::EventActionDescriptor& descriptor)
+    void eventActionDispatchStart(WTF::EventActionId id, WTF::EventActionId originalId, const WTF::EventActionDescriptor& descriptor, double registeredAt = -1)
     {
         ASSERT(!m_isDispatching);
 
         m_originalToNewEventActionIdMap.insert(std::pair<int, int>(originalId, id));
 
-        m_dispatchHistory->append(EventActionScheduleItem(id, descriptor));
+        m_dispatching = EventActionScheduleItem(id, descriptor);
         m_isDispatching = true;
+
+        if (m_profiler) {
+            m_profiler->enterEventAction(registeredAt);
+        }
     }
 
     void eventActionDispatchEnd(bool commit, WTF::EventActionId originalId)
@@ -139,20 +160,33 @@ private:
 
         m_isDispatching = false;
 
+        if (m_profiler) {
+            m_profiler->exitEventAction(m_dispatching.first, m_dispatching.second, commit);
+        }
+
         if (!commit) {
             m_originalToNewEventActionIdMap.erase(originalId);
-            m_dispatchHistory->removeLast();
+            return;
         }
+
+        m_dispatchHistory->append(m_dispatching);
+
+        notifyEventActionObservers(m_dispatching.first, m_dispatching.second);
     }
 
+    void notifyEventActionObservers(WTF::EventActionId id, const WTF::EventActionDescriptor& descriptor);
+
     EventActionRegisterMaps* m_maps;
     bool m_isDispatching;
 
-    EventActionSchedule* m_dispatchHistory;
+    EventActionScheduleWriter* m_dispatchHistory;
+    EventActionScheduleItem m_dispatching; // the event action being dispatched, valid while m_isDispatching
 
     bool m_verbose;
 
     std::map<int, int> m_originalToNewEventActionIdMap;
+
+    EventActionProfiler* m_profiler;
 };
 
 }  // namespace WebCore
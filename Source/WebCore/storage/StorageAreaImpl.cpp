@@ -36,6 +36,7 @@
 #include "StorageAreaSync.h"
 #include "StorageEventDispatcher.h"
 #include "StorageMap.h"
+#include "StorageSnapshot.h"
 #include "StorageSyncManager.h"
 #include "StorageTracker.h"
 #include <wtf/MainThread.h>
@@ -45,6 +46,9 @@ namespace WebCore {
 StorageAreaImpl::~StorageAreaImpl()
 {
     ASSERT(isMainThread());
+
+    if (StorageSnapshot::isEnabled())
+        StorageSnapshot::willDestroyStorageArea(this);
 }
 
 inline StorageAreaImpl::StorageAreaImpl(StorageType storageType, PassRefPtr<SecurityOrigin> origin, PassRefPtr<StorageSyncManager> syncManager, unsigned quota)
@@ -63,6 +67,9 @@ inline StorageAreaImpl::StorageAreaImpl(StorageType storageType, PassRefPtr<Secu
     // Accessing the shared global StorageTracker when a StorageArea is created 
     // ensures that the tracker is properly initialized before anyone actually needs to use it.
     StorageTracker::tracker();
+
+    if (StorageSnapshot::isEnabled())
+        StorageSnapshot::didCreateStorageArea(this);
 }
 
 PassRefPtr<StorageAreaImpl> StorageAreaImpl::create(StorageType storageType, PassRefPtr<SecurityOrigin> origin, PassRefPtr<StorageSyncManager> syncManager, unsigned quota)
@@ -76,6 +83,10 @@ PassRefPtr<StorageAreaImpl> StorageAreaImpl::create(StorageType storageType, Pas
         ASSERT(area->m_storageAreaSync);
     }
 
+    // WebERA: Storage is kept in memory only, start from the recorded items.
+    if (StorageSnapshot::isEnabled())
+        StorageSnapshot::importItems(area.get());
+
     return area.release();
 }
 
@@ -98,6 +109,9 @@ StorageAreaImpl::StorageAreaImpl(StorageAreaImpl* area)
     ASSERT(m_securityOrigin);
     ASSERT(m_storageMap);
     ASSERT(!m_isShutdown);
+
+    if (StorageSnapshot::isEnabled())
+        StorageSnapshot::didCreateStorageArea(this);
 }
 
 bool StorageAreaImpl::disabledByPrivateBrowsingInFrame(const Frame* frame) const
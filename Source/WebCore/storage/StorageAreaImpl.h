@@ -64,6 +64,10 @@ namespace WebCore {
 
         void sync();
 
+        // WebERA: See StorageSnapshot.
+        StorageType storageType() const { return m_storageType; }
+        SecurityOrigin* securityOrigin() const { return m_securityOrigin.get(); }
+
     private:
         StorageAreaImpl(StorageType, PassRefPtr<SecurityOrigin>, PassRefPtr<StorageSyncManager>, unsigned quota);
         StorageAreaImpl(StorageAreaImpl*);
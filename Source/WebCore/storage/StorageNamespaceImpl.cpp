@@ -29,6 +29,7 @@
 #include "SecurityOriginHash.h"
 #include "StorageAreaImpl.h"
 #include "StorageMap.h"
+#include "StorageSnapshot.h"
 #include "StorageSyncManager.h"
 #include "StorageTracker.h"
 #include <wtf/MainThread.h>
@@ -70,7 +71,8 @@ StorageNamespaceImpl::StorageNamespaceImpl(StorageType storageType, const String
     , m_quota(quota)
     , m_isShutdown(false)
 {
-    if (m_storageType == LocalStorage && !m_path.isEmpty())
+    // WebERA: The snapshot backend never syncs localStorage to disk.
+    if (m_storageType == LocalStorage && !m_path.isEmpty() && !StorageSnapshot::isEnabled())
         m_syncManager = StorageSyncManager::create(m_path);
 }
 
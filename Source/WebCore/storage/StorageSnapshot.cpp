@@ -0,0 +1,263 @@
+/*
+ * StorageSnapshot.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "config.h"
+#include "StorageSnapshot.h"
+
+#include "SecurityOrigin.h"
+#include "StorageAreaImpl.h"
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <wtf/HashMap.h>
+#include <wtf/MainThread.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/Vector.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/StringHash.h>
+
+namespace WebCore {
+
+namespace {
+
+const char snapshotMagic[4] = { 'E', 'R', 'S', 'S' };
+const uint32_t snapshotVersion = 1;
+
+bool s_enabled = false;
+
+struct SnapshotArea {
+    SnapshotArea()
+        : type(LocalStorage)
+    {
+    }
+
+    StorageType type;
+    String origin;
+    Vector<std::pair<String, String> > items;
+};
+
+// Keyed on the type and the origin identifier, see areaKey().
+typedef HashMap<String, SnapshotArea> SnapshotAreaMap;
+
+SnapshotAreaMap& loadedAreas()
+{
+    DEFINE_STATIC_LOCAL(SnapshotAreaMap, areas, ());
+    return areas;
+}
+
+// Live storage areas and the order they were created in.
+typedef HashMap<StorageAreaImpl*, unsigned> LiveAreaMap;
+
+LiveAreaMap& liveAreas()
+{
+    DEFINE_STATIC_LOCAL(LiveAreaMap, areas, ());
+    return areas;
+}
+
+unsigned s_createdAreas = 0;
+
+String areaKey(StorageType type, const String& origin)
+{
+    return String::number(type) + " " + origin;
+}
+
+class SnapshotReader {
+public:
+    explicit SnapshotReader(FILE* f)
+        : m_file(f)
+    {
+    }
+
+    bool read(void* value, size_t size) { return fread(value, 1, size, m_file) == size; }
+    bool readUInt32(uint32_t* value) { return read(value, sizeof(*value)); }
+
+    bool readString(String* value)
+    {
+        uint32_t length;
+        if (!readUInt32(&length))
+            return false;
+        Vector<UChar> characters;
+        if (!characters.tryReserveCapacity(length))
+            return false;
+        characters.resize(length);
+        if (!read(characters.data(), length * sizeof(UChar)))
+            return false;
+        *value = String(characters.data(), length);
+        return true;
+    }
+
+private:
+    FILE* m_file;
+};
+
+void writeUInt32(FILE* f, uint32_t value)
+{
+    fwrite(&value, sizeof(value), 1, f);
+}
+
+void writeString(FILE* f, const String& value)
+{
+    writeUInt32(f, value.length());
+    fwrite(value.characters(), sizeof(UChar), value.length(), f);
+}
+
+bool itemKeyLessThan(const std::pair<String, String>& a, const std::pair<String, String>& b)
+{
+    return codePointCompareLessThan(a.first, b.first);
+}
+
+// Areas and their items are written sorted by key, such that equal states give equal files.
+bool saveAreas(const String& path, const SnapshotAreaMap& areas)
+{
+    FILE* f = fopen(path.utf8().data(), "wb");
+    if (!f)
+        return false;
+
+    Vector<String> keys;
+    copyKeysToVector(areas, keys);
+    std::sort(keys.begin(), keys.end(), codePointCompareLessThan);
+
+    fwrite(snapshotMagic, 1, sizeof(snapshotMagic), f);
+    writeUInt32(f, snapshotVersion);
+    writeUInt32(f, areas.size());
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        SnapshotArea area = areas.get(keys[i]);
+        std::sort(area.items.begin(), area.items.end(), itemKeyLessThan);
+        writeUInt32(f, area.type);
+        writeString(f, area.origin);
+        writeUInt32(f, area.items.size());
+        for (size_t j = 0; j < area.items.size(); ++j) {
+            writeString(f, area.items[j].first);
+            writeString(f, area.items[j].second);
+        }
+    }
+
+    bool ok = !ferror(f);
+    return !fclose(f) && ok;
+}
+
+}
+
+void StorageSnapshot::setEnabled(bool enabled)
+{
+    s_enabled = enabled;
+}
+
+bool StorageSnapshot::isEnabled()
+{
+    return s_enabled;
+}
+
+bool StorageSnapshot::load(const String& path)
+{
+    loadedAreas().clear();
+
+    FILE* f = fopen(path.utf8().data(), "rb");
+    if (!f)
+        return false;
+
+    SnapshotReader reader(f);
+    SnapshotAreaMap areas;
+
+    char magic[sizeof(snapshotMagic)];
+    uint32_t version;
+    uint32_t count;
+    bool ok = reader.read(magic, sizeof(magic)) && !memcmp(magic, snapshotMagic, sizeof(magic))
+        && reader.readUInt32(&version) && version == snapshotVersion && reader.readUInt32(&count);
+
+    for (uint32_t i = 0; ok && i < count; ++i) {
+        SnapshotArea area;
+        uint32_t type;
+        uint32_t numItems;
+        ok = reader.readUInt32(&type) && (type == LocalStorage || type == SessionStorage)
+            && reader.readString(&area.origin) && reader.readUInt32(&numItems);
+        area.type = static_cast<StorageType>(type);
+
+        for (uint32_t j = 0; ok && j < numItems; ++j) {
+            String key;
+            String value;
+            ok = reader.readString(&key) && reader.readString(&value);
+            area.items.append(std::make_pair(key, value));
+        }
+
+        if (ok)
+            areas.set(areaKey(area.type, area.origin), area);
+    }
+
+    fclose(f);
+
+    // A partial snapshot would diverge from the recording in a less obvious way than an empty one.
+    if (!ok)
+        return false;
+
+    loadedAreas().swap(areas);
+    return true;
+}
+
+bool StorageSnapshot::saveInitialState(const String& path)
+{
+    return saveAreas(path, loadedAreas());
+}
+
+bool StorageSnapshot::saveCurrentState(const String& path)
+{
+    ASSERT(isMainThread());
+
+    SnapshotAreaMap areas = loadedAreas();
+    HashMap<String, unsigned> savedAreaCreationOrder;
+
+    LiveAreaMap::const_iterator end = liveAreas().end();
+    for (LiveAreaMap::const_iterator it = liveAreas().begin(); it != end; ++it) {
+        StorageAreaImpl* storageArea = it->first;
+
+        SnapshotArea area;
+        area.type = storageArea->storageType();
+        area.origin = storageArea->securityOrigin()->databaseIdentifier();
+
+        unsigned length = storageArea->length(0);
+        for (unsigned i = 0; i < length; ++i) {
+            String key = storageArea->key(i, 0);
+            area.items.append(std::make_pair(key, storageArea->getItem(key, 0)));
+        }
+
+        // Copies of a sessionStorage area (made for pages opened by the page) share its origin. The original,
+        // created first, wins regardless of the order of the live areas.
+        String key = areaKey(area.type, area.origin);
+        HashMap<String, unsigned>::AddResult saved = savedAreaCreationOrder.add(key, it->second);
+        if (!saved.isNewEntry && saved.iterator->second < it->second)
+            continue;
+        saved.iterator->second = it->second;
+        areas.set(key, area);
+    }
+
+    return saveAreas(path, areas);
+}
+
+void StorageSnapshot::importItems(StorageAreaImpl* storageArea)
+{
+    SnapshotAreaMap::const_iterator it = loadedAreas().find(areaKey(storageArea->storageType(), storageArea->securityOrigin()->databaseIdentifier()));
+    if (it == loadedAreas().end())
+        return;
+
+    const Vector<std::pair<String, String> >& items = it->second.items;
+    for (size_t i = 0; i < items.size(); ++i)
+        storageArea->importItem(items[i].first, items[i].second);
+}
+
+void StorageSnapshot::didCreateStorageArea(StorageAreaImpl* storageArea)
+{
+    liveAreas().add(storageArea, s_createdAreas++);
+}
+
+void StorageSnapshot::willDestroyStorageArea(StorageAreaImpl* storageArea)
+{
+    liveAreas().remove(storageArea);
+}
+
+} // namespace WebCore
@@ -0,0 +1,50 @@
+/*
+ * StorageSnapshot.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef StorageSnapshot_h
+#define StorageSnapshot_h
+
+#include <wtf/Forward.h>
+
+namespace WebCore {
+
+class StorageAreaImpl;
+
+// WebERA: In-memory backend of localStorage and sessionStorage for recording and replaying.
+//
+// When enabled, localStorage is never synced to disk (no SQLite database and no storage thread), such that
+// parallel runs of the same site do not share files. Instead, the initial items of all storage areas are
+// loaded from a snapshot file written by the recording, and the state at the end of a run can be written
+// to the output directory.
+//
+// A snapshot file starts with the magic "ERSS" and a version, followed by each storage area as its type,
+// origin identifier and items, both sorted by key. All strings are stored as their length and UTF-16 code units.
+class StorageSnapshot {
+public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // Loads the initial items of the storage areas. Returns false if the file can not be read, the storage
+    // areas are empty then.
+    static bool load(const String& path);
+
+    // Writes the snapshot the run started from (the loaded one).
+    static bool saveInitialState(const String& path);
+    // Writes the items of all storage areas, including loaded ones not accessed by the page.
+    static bool saveCurrentState(const String& path);
+
+    // Imports the loaded items of a new storage area.
+    static void importItems(StorageAreaImpl*);
+
+    // Storage areas (and their copies) are tracked from creation to destruction, for saveCurrentState().
+    static void didCreateStorageArea(StorageAreaImpl*);
+    static void willDestroyStorageArea(StorageAreaImpl*);
+};
+
+} // namespace WebCore
+
+#endif // StorageSnapshot_h
@@ -30,6 +30,7 @@
 #include "V8Binding.h"
 #include <QJSEngine>
 #endif
+#include "DOMTimer.h"
 #include "Document.h"
 #include "DocumentLoader.h"
 #include "DragData.h"
@@ -125,6 +126,7 @@ QTM_USE_NAMESPACE
 
 #include <WebCore/platform/ThreadGlobalData.h>
 #include <WebCore/platform/ThreadTimers.h>
+#include <WebCore/platform/network/qt/QNetworkReplyHandler.h>
 
 using namespace WebCore;
 
@@ -725,6 +727,22 @@ QString QWebFrame::toHtml() const
     return createMarkup(d->frame->document());
 }
 
+/*!
+    WebERA: Returns a hash of the frame's DOM content.
+
+    The hash is maintained incrementally by the document, thus this is a cheap alternative to
+    hashing the result of toHtml(). Child frames are not included. Returns 0 unless the hash is
+    enabled with DumpRenderTreeSupportQt::setContentHashEnabled() before the page is loaded.
+
+    \sa toHtml()
+*/
+quint64 QWebFrame::contentHash() const
+{
+    if (!d->frame->document())
+        return 0;
+    return d->frame->document()->contentHash();
+}
+
 /*!
     Returns the content of this frame converted to plain text, completely
     stripped of all HTML formatting.
@@ -938,6 +956,12 @@ void QWebFrame::load(const QUrl &url)
     // WebERA:
     m_loadUrl = url;
 
+    // Timers and requests of the new page are numbered from 0, in the same order when replaying.
+    if (d->page->mainFrame() == this) {
+        DOMTimer::resetSameUrlSequenceNumbers();
+        QNetworkReplyInitialSnapshot::resetSameUrlSequenceNumbers();
+    }
+
     d->m_loadTimer.setEventActionDescriptor(WTF::EventActionDescriptor(
                     WTF::USER_INTERFACE,
                     "BrowserLoadUrl",
@@ -136,6 +136,7 @@ public:
     void addToJavaScriptWindowObject(const QString &name, QObject *object);
     void addToJavaScriptWindowObject(const QString &name, QObject *object, QScriptEngine::ValueOwnership ownership);
     QString toHtml() const;
+    quint64 contentHash() const;
     QString toPlainText() const;
     QString renderTreeDump() const;
 
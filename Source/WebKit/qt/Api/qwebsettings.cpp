@@ -217,6 +217,10 @@ void QWebSettingsPrivate::apply()
                                       global->attributes.value(QWebSettings::FrameFlatteningEnabled));
         settings->setFrameFlatteningEnabled(value);
 
+        value = attributes.value(QWebSettings::PaintingSuppressed,
+                                      global->attributes.value(QWebSettings::PaintingSuppressed));
+        settings->setPaintingSuppressed(value);
+
         QUrl location = !userStyleSheetLocation.isEmpty() ? userStyleSheetLocation : global->userStyleSheetLocation;
         settings->setUserStyleSheetLocation(WebCore::KURL(location));
 
@@ -476,6 +480,9 @@ QWebSettings* QWebSettings::globalSettings()
         This is disabled by default.
     \value SiteSpecificQuirksEnabled This setting enables WebKit's workaround for broken sites. It is
         enabled by default.
+    \value PaintingSuppressed With this setting the page is laid out as usual, but nothing is painted and
+        the view is not updated. Disabling it again repaints the whole view, e.g. before rendering a screenshot.
+        This is disabled by default.
 */
 
 /*!
@@ -526,6 +533,7 @@ QWebSettings::QWebSettings()
     d->attributes.insert(QWebSettings::TiledBackingStoreEnabled, false);
     d->attributes.insert(QWebSettings::FrameFlatteningEnabled, false);
     d->attributes.insert(QWebSettings::SiteSpecificQuirksEnabled, true);
+    d->attributes.insert(QWebSettings::PaintingSuppressed, false);
     d->offlineStorageDefaultQuota = 5 * 1024 * 1024;
     d->defaultTextEncoding = QLatin1String("iso-8859-1");
 #if QT_VERSION >= QT_VERSION_CHECK(4, 8, 0)
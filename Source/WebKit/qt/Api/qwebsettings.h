@@ -82,7 +82,8 @@ public:
         JavascriptCanCloseWindows,
         WebGLEnabled,
         CSSRegionsEnabled,
-        HyperlinkAuditingEnabled
+        HyperlinkAuditingEnabled,
+        PaintingSuppressed
     };
     enum WebGraphic {
         MissingImageGraphic,
@@ -57,6 +57,7 @@
 #include "ScrollbarTheme.h"
 #include "SearchPopupMenuQt.h"
 #include "SecurityOrigin.h"
+#include "Settings.h"
 #include "ViewportArguments.h"
 #include "WindowFeatures.h"
 
@@ -400,6 +401,9 @@ IntRect ChromeClientQt::windowResizerRect() const
 void ChromeClientQt::invalidateRootView(const IntRect& windowRect, bool)
 {
 #if USE(TILED_BACKING_STORE)
+    if (paintingSuppressed())
+        return;
+
     if (platformPageClient()) {
         WebCore::TiledBackingStore* backingStore = QWebFramePrivate::core(m_webPage->mainFrame())->tiledBackingStore();
         if (!backingStore)
@@ -413,6 +417,10 @@ void ChromeClientQt::invalidateRootView(const IntRect& windowRect, bool)
 
 void ChromeClientQt::invalidateContentsAndRootView(const IntRect& windowRect, bool immediate)
 {
+    // WebERA: Settings::setPaintingSuppressed(false) invalidates the whole view again.
+    if (paintingSuppressed())
+        return;
+
     // No double buffer, so only update the QWidget if content changed.
     if (platformPageClient()) {
         QRect rect(windowRect);
@@ -433,7 +441,7 @@ void ChromeClientQt::invalidateContentsForSlowScroll(const IntRect& windowRect,
 
 void ChromeClientQt::scroll(const IntSize& delta, const IntRect& scrollViewRect, const IntRect&)
 {
-    if (platformPageClient())
+    if (platformPageClient() && !paintingSuppressed())
         platformPageClient()->scroll(delta.width(), delta.height(), scrollViewRect);
     emit m_webPage->scrollRequested(delta.width(), delta.height(), scrollViewRect);
 }
@@ -480,6 +488,11 @@ PlatformPageClient ChromeClientQt::platformPageClient() const
     return m_webPage->d->client.get();
 }
 
+bool ChromeClientQt::paintingSuppressed() const
+{
+    return m_webPage->d->page->settings()->paintingSuppressed();
+}
+
 void ChromeClientQt::contentsSizeChanged(Frame* frame, const IntSize& size) const
 {
     if (frame->loader()->networkingContext())
@@ -182,6 +182,8 @@ public:
 
     PassOwnPtr<QWebSelectMethod> createSelectPopup() const;
 
+    bool paintingSuppressed() const;
+
     virtual void dispatchViewportPropertiesDidChange(const ViewportArguments&) const;
 
     virtual bool shouldRubberBandInDirection(WebCore::ScrollDirection) const { return true; }
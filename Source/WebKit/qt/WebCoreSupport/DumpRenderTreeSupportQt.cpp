@@ -426,6 +426,36 @@ int DumpRenderTreeSupportQt::javaScriptObjectsCount()
 #endif
 }
 
+#if USE(JSC)
+// "<name>: <count> <total ms> <max ms>" followed by the bucket counts of the histogram.
+static QString pauseHistogramAsText(const char* name, const JSC::GCPauseHistogram& histogram)
+{
+    QStringList buckets;
+    for (size_t i = 0; i < JSC::GCPauseHistogram::bucketCount; ++i)
+        buckets.append(QString::number(histogram.bucket(i)));
+
+    return QString::fromLatin1("%1: %2 %3 %4\n%1-histogram: %5\n").arg(QLatin1String(name))
+        .arg(histogram.count()).arg(histogram.total() * 1000, 0, 'f', 3).arg(histogram.max() * 1000, 0, 'f', 3)
+        .arg(buckets.join(QLatin1String(" ")));
+}
+#endif
+
+QString DumpRenderTreeSupportQt::garbageCollectorStatistics()
+{
+#if USE(JSC)
+    const JSC::GCStatistics& statistics = JSDOMWindowBase::commonJSGlobalData()->heap.statistics();
+    return pauseHistogramAsText("GC-collections", statistics.collections())
+        + pauseHistogramAsText("GC-sweep-slices", statistics.sweepSlices());
+#else
+    return QString();
+#endif
+}
+
+void DumpRenderTreeSupportQt::setContentHashEnabled(bool enabled)
+{
+    Document::setContentHashEnabled(enabled);
+}
+
 void DumpRenderTreeSupportQt::garbageCollectorCollect()
 {
 #if USE(JSC)
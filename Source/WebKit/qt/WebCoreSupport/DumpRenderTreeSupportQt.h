@@ -128,6 +128,10 @@ public:
     static void setJavaScriptProfilingEnabled(QWebFrame*, bool enabled);
     static void setValueForUser(const QWebElement&, const QString& value);
     static int javaScriptObjectsCount();
+    // WebERA: Pause times of the garbage collector as status lines, see JSC::GCStatistics.
+    static QString garbageCollectorStatistics();
+    // WebERA: Maintain the DOM content hash (QWebFrame::contentHash()) of documents created from now on.
+    static void setContentHashEnabled(bool);
     static void clearScriptWorlds();
     static void evaluateScriptInIsolatedWorld(QWebFrame* frame, int worldID, const QString& script);
 
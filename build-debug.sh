@@ -12,3 +12,13 @@ cd Replay
 echo "Compiling R4/clients/Replay..."
 qmake CONFIG+=debug
 make
+cd ..
+cd NetworkService
+echo "Compiling R4/clients/NetworkService..."
+qmake CONFIG+=debug
+make
+cd ..
+cd ActionLogConvert
+echo "Compiling R4/clients/ActionLogConvert..."
+qmake CONFIG+=debug
+make
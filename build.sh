@@ -11,3 +11,13 @@ cd Replay
 echo "Compiling R4/clients/Replay..."
 qmake
 make
+cd ..
+cd NetworkService
+echo "Compiling R4/clients/NetworkService..."
+qmake
+make
+cd ..
+cd ActionLogConvert
+echo "Compiling R4/clients/ActionLogConvert..."
+qmake
+make